@@ -163,6 +163,18 @@ namespace voom
     //! Access the container of nodes
     InternalNodeContainer& internalNodes() { return _iNodes; }
 
+    //! Copy the ionic state from the internal nodes (after changing them)
+    void loadInternalNodes();
+
+    //! Copy the ionic state to the internal nodes (e.g. for output)
+    void storeInternalNodes();
+
+    //! Tabulate exp(-dt/tau) of the twelve gates of gate_table
+    /*! Must be called, outside of any parallel region, after
+      gate_table is filled and before compute_ion is called with
+      time step dt. */
+    static void tabulateGateExponentials(float dt);
+
     //! Structure to hold together everything needed at a quad point
     /*! Stuff needed at each quad point includes the quad weight,
       shape functions and their derivatives evaluated at the point,
@@ -196,9 +208,20 @@ namespace voom
     int _cell_type;
     blitz::Array<float, 2> _dummy_matrix;
 
+    //! Ionic state of all quad points, _state[k*Q+q] for variable k
+    //! (internal node index 0-18) at quad point q
+    std::vector<float> _state;
+
+    //! scratch for compute_ion: nodal voltages and currents
+    std::vector<float> _vn;
+    std::vector<float> _fn;
+
 
   public:
     static float gate_table[1701][25];
+    //! exp(-dt/tau) of gate k at row i of gate_table, for dt = gate_dt
+    static float gate_exp[1701][12];
+    static float gate_dt;
     static float Gna;
     static float GK1;
     static float Gto;
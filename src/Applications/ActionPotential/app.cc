@@ -139,6 +139,8 @@ ofstream ofsecg("./data1/ECG.dat");
  */
 
 float ElementType::gate_table[1701][25];
+float ElementType::gate_exp[1701][12];
+float ElementType::gate_dt=-1.0;
 float ElementType::Gna=7.8;
 float ElementType::GK1=3.0*0.09;
 float ElementType::Gto=1.0*0.1652;
@@ -581,6 +583,7 @@ int main(int argc, char* argv[])
   double curr_time=0.0;
   // The time step of the system
   float dt=0.05;
+  ElementType::tabulateGateExponentials(dt);
   // The stimulus strength;
   double istim=0.0;
   // These variables correspond to the when to start and end the pacing
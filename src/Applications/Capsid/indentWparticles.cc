@@ -503,6 +503,8 @@ int main(int argc, char* argv[])
 
   // Then initialize potential body
   PotentialBody * PrBody = new PotentialBody(&Mat,defNodes,PotentialSearchRF);  
+  // evaluate each protein pair once
+  PrBody->setPairList(true);
   PrBody->compute(true, false, false);
   std::cout << "Initial protein body energy = " << PrBody->energy() << endl;    
 
@@ -191,7 +191,7 @@ int main(int argc, char* argv[]) {
   Vector2D gridSpaces;
   gridSpaces[0] = maxPPsep/(2.0*sqrt(2.0));
   gridSpaces[1] = maxPPsep/(2.0*sqrt(2.0));
-  Grid<Fil,Fil,2> * grid = new Grid<Fil,Fil,2>(box,gridSpaces,&Fil::point,true);
+  Grid<Fil,Fil,2> * grid = new Grid<Fil,Fil,2>(box,gridSpaces,&Fil::point,false);
   gridSpaces = grid->gridSpace();
   maxPPsep = gridSpaces[0]*4.0*sqrt(2.0);
   ssstream.str("");
@@ -6,11 +6,43 @@
 //                 (C) 2004-2005 All Rights Reserved
 //
 //----------------------------------------------------------------------
+#include <map>
 #include "Body.h"
 
 
 namespace voom {
 
+  const Body::ColorContainer & Body::elementColors() {
+    if(_coloredElements == _elements.size()) return _colors;
+
+    // Greedy coloring: each element takes the lowest color not yet
+    // used by any of its nodes.
+    _colors.clear();
+    std::map<const NodeBase*, std::vector<int> > used;
+    for(int e=0; e<_elements.size(); e++) {
+      const Element::BaseNodeContainer & nodes = _elements[e]->baseNodes();
+      if(nodes.size() == 0) {
+	// unknown connectivity; compute it alone
+	_colors.push_back( std::vector<int>(1,e) );
+	continue;
+      }
+
+      std::vector<bool> taken(_colors.size(), false);
+      for(int a=0; a<nodes.size(); a++) {
+	const std::vector<int> & c = used[nodes[a]];
+	for(int k=0; k<c.size(); k++) taken[c[k]] = true;
+      }
+      int color=0;
+      while(color < taken.size() && taken[color]) color++;
+      if(color == _colors.size()) _colors.push_back( std::vector<int>() );
+
+      _colors[color].push_back(e);
+      for(int a=0; a<nodes.size(); a++) used[nodes[a]].push_back(color);
+    }
+    _coloredElements = _elements.size();
+    return _colors;
+  }
+
   //! check consistency of derivatives
   void Body::checkConsistency(bool verbose) {
 
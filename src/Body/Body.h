@@ -68,9 +68,12 @@ namespace voom
     typedef std::vector<NodeBase*> NodeContainer;
     typedef NodeContainer::iterator NodeIterator;
     typedef NodeContainer::const_iterator ConstNodeIterator;
+
+    //! Element indices grouped by color
+    typedef std::vector< std::vector<int> > ColorContainer;
     
     //! Default Constructor
-    Body() {_output=paraview; _energy=0.0;}
+    Body() {_output=paraview; _energy=0.0; _coloredElements=-1; _connectivity=0;}
     
     //! Default Destructor
     virtual ~Body() {};
@@ -91,7 +94,28 @@ namespace voom
     NodeContainer & nodes() {return _nodes;}
 
     //! Add an element to the list
-    virtual void addElement( Element * e ) { _elements.push_back( e ); }
+    virtual void addElement( Element * e ) { 
+      _elements.push_back( e ); 
+      _connectivity++;
+    }
+
+    //! Connectivity generation
+    /*! Incremented whenever elements or the nodes they couple change,
+      so that a Model can tell when its sparsity pattern is stale.
+      Bodies that rebuild elements or neighbor lists must call
+      connectivityChanged().
+    */
+    unsigned long connectivity() const { return _connectivity; }
+
+    void connectivityChanged() { _connectivity++; }
+
+    //! Elements partitioned so that no two elements of one color
+    //! share a node
+    /*! Elements of one color can be computed concurrently without
+      contention on nodal forces.  The coloring is (re)built whenever
+      the number of elements has changed since it was last built.
+    */
+    const ColorContainer & elementColors();
 
     //! Add a node to the list
     virtual void addNode( NodeBase * n ) { 
@@ -138,6 +162,15 @@ namespace voom
     ConstraintContainer _constraints;
 
     double _energy;
+
+    //! Color classes of _elements, see elementColors()
+    ColorContainer _colors;
+
+    //! Number of elements when _colors was built
+    int _coloredElements;
+
+    //! Connectivity generation, see connectivity()
+    unsigned long _connectivity;
     
   };
 
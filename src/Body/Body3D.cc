@@ -100,15 +100,20 @@ namespace voom
     // Need to zero out stiffness too!!!!!!!!!!
 
     // compute energy, forces and stiffness matrix in each element
-    // loop through all elements
+    // loop through element colors; elements of one color share no
+    // nodes, so their force accumulation does not contend
+    const ColorContainer & colors = elementColors();
+    for(int c = 0; c < colors.size(); c++)
+    {
+      const std::vector<int> & batch = colors[c];
 #ifdef _OPENMP	
 #pragma omp parallel for 		\
   schedule(static) default(shared) 
 #endif	
-
-    for(int e = 0; e < _elements.size(); e++)
-    {
-      _elements[e]->compute( f0, f1, f2);      
+      for(int b = 0; b < batch.size(); b++)
+      {
+	_elements[ batch[b] ]->compute( f0, f1, f2);      
+      }
     }
 
     if(f0)
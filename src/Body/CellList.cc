@@ -0,0 +1,187 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+
+#include <algorithm>
+#include <limits>
+#include "CellList.h"
+
+namespace voom {
+
+  int CellList::_cellIndex(int d, double x) const {
+    int i = static_cast<int>( std::floor((x - _min[d])/_cell[d]) );
+    if(_period[d] > 0.0) {
+      i %= _n[d];
+      if(i < 0) i += _n[d];
+    } else {
+      i = std::max(0, std::min(i, _n[d]-1));
+    }
+    return i;
+  }
+
+  bool CellList::needsRebuild(const std::vector<double> & x) const {
+    if( !_built || x.size() != _x0.size() ) return true;
+    const double limit = 0.5*_skin;
+    const int nP = x.size()/3;
+    for(int i=0; i<nP; i++) {
+      if( distance(&x[3*i], &_x0[3*i]) > limit ) return true;
+    }
+    return false;
+  }
+
+  bool CellList::update(const std::vector<double> & x) {
+    if( !needsRebuild(x) ) return false;
+    _build(x);
+    return true;
+  }
+
+  void CellList::_build(const std::vector<double> & x) {
+    const int nP = x.size()/3;
+    const double cutoff = _radius + _skin;
+    _x0 = x;
+    _candidates.clear();
+    _built = true;
+    if(nP == 0) return;
+
+    // grid geometry: cells at least as large as the cutoff
+    double width = std::max(cutoff, std::numeric_limits<double>::min());
+    double extent[3];
+    for(int d=0; d<3; d++) {
+      if(_period[d] > 0.0) {
+	_min[d] = 0.0;
+	_n[d] = std::max(1, static_cast<int>(_period[d]/width));
+	_cell[d] = _period[d]/_n[d];
+      } else {
+	double lo = x[d], hi = x[d];
+	for(int i=1; i<nP; i++) {
+	  lo = std::min(lo, x[3*i+d]);
+	  hi = std::max(hi, x[3*i+d]);
+	}
+	_min[d] = lo;
+	extent[d] = hi-lo;
+	_cell[d] = width;
+	_n[d] = static_cast<int>(extent[d]/width) + 1;
+      }
+    }
+
+    // keep the number of cells proportional to the number of points
+    // for sparse clouds in large boxes
+    const double maxCells = 8.0*nP + 27.0;
+    while( static_cast<double>(_n[0])*_n[1]*_n[2] > maxCells ) {
+      for(int d=0; d<3; d++) {
+	if(_period[d] > 0.0) {
+	  _n[d] = std::max(1, static_cast<int>(_n[d]/1.26));
+	  _cell[d] = _period[d]/_n[d];
+	} else {
+	  _cell[d] *= 1.26;
+	  _n[d] = static_cast<int>(extent[d]/_cell[d]) + 1;
+	}
+      }
+    }
+    const int nCells = _n[0]*_n[1]*_n[2];
+
+    // counting sort of points into cells
+    IndexContainer cellOf(nP), start(nCells+1, 0), order(nP);
+    for(int i=0; i<nP; i++) {
+      const int c = _cellIndex(0, x[3*i])
+	+ _n[0]*( _cellIndex(1, x[3*i+1]) + _n[1]*_cellIndex(2, x[3*i+2]) );
+      cellOf[i] = c;
+      start[c+1]++;
+    }
+    for(int c=0; c<nCells; c++) start[c+1] += start[c];
+    IndexContainer fill(start.begin(), start.end()-1);
+    for(int i=0; i<nP; i++) order[ fill[cellOf[i]]++ ] = i;
+
+    // search each cell against itself and its higher-numbered neighbors
+    IndexContainer adjacent;
+    for(int cz=0; cz<_n[2]; cz++) {
+      for(int cy=0; cy<_n[1]; cy++) {
+	for(int cx=0; cx<_n[0]; cx++) {
+	  const int c = cx + _n[0]*(cy + _n[1]*cz);
+	  if(start[c] == start[c+1]) continue;
+
+	  adjacent.clear();
+	  for(int dz=-1; dz<=1; dz++) {
+	    int nz = cz+dz;
+	    if(_period[2] > 0.0) nz = (nz + _n[2]) % _n[2];
+	    else if(nz < 0 || nz >= _n[2]) continue;
+	    for(int dy=-1; dy<=1; dy++) {
+	      int ny = cy+dy;
+	      if(_period[1] > 0.0) ny = (ny + _n[1]) % _n[1];
+	      else if(ny < 0 || ny >= _n[1]) continue;
+	      for(int dx=-1; dx<=1; dx++) {
+		int nx = cx+dx;
+		if(_period[0] > 0.0) nx = (nx + _n[0]) % _n[0];
+		else if(nx < 0 || nx >= _n[0]) continue;
+		const int nc = nx + _n[0]*(ny + _n[1]*nz);
+		if(nc > c) adjacent.push_back(nc);
+	      }
+	    }
+	  }
+	  // small periodic grids wrap onto the same cell more than once
+	  std::sort(adjacent.begin(), adjacent.end());
+	  adjacent.erase( std::unique(adjacent.begin(), adjacent.end()),
+			  adjacent.end() );
+
+	  for(int a=start[c]; a<start[c+1]; a++) {
+	    const int i = order[a];
+	    for(int b=a+1; b<start[c+1]; b++) {
+	      const int j = order[b];
+	      if( distance(&x[3*i], &x[3*j]) <= cutoff ) {
+		_candidates.push_back(std::min(i,j));
+		_candidates.push_back(std::max(i,j));
+	      }
+	    }
+	    for(int k=0; k<adjacent.size(); k++) {
+	      const int nc = adjacent[k];
+	      for(int b=start[nc]; b<start[nc+1]; b++) {
+		const int j = order[b];
+		if( distance(&x[3*i], &x[3*j]) <= cutoff ) {
+		  _candidates.push_back(std::min(i,j));
+		  _candidates.push_back(std::max(i,j));
+		}
+	      }
+	    }
+	  }
+	}
+      }
+    }
+    return;
+  }
+
+  void CellList::neighbors(const std::vector<double> & x, double r,
+			   std::vector< IndexContainer > & lists) {
+    update(x);
+    const int nP = x.size()/3;
+    lists.assign(nP, IndexContainer());
+    for(int k=0; k<_candidates.size(); k+=2) {
+      const int i = _candidates[k], j = _candidates[k+1];
+      if( distance(&x[3*i], &x[3*j]) <= r ) {
+	lists[i].push_back(j);
+	lists[j].push_back(i);
+      }
+    }
+    // deterministic order, independent of the grid
+    for(int i=0; i<nP; i++) std::sort(lists[i].begin(), lists[i].end());
+    return;
+  }
+
+  void CellList::pairs(const std::vector<double> & x, double r, IndexContainer & ij) {
+    update(x);
+    ij.clear();
+    for(int k=0; k<_candidates.size(); k+=2) {
+      const int i = _candidates[k], j = _candidates[k+1];
+      if( distance(&x[3*i], &x[3*j]) <= r ) {
+	ij.push_back(i);
+	ij.push_back(j);
+      }
+    }
+    return;
+  }
+
+}; // namespace voom
@@ -0,0 +1,128 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+
+/*!
+  \file CellList.h
+
+  \brief CellList is a uniform-grid neighbor search for clouds of 3D
+  points, with Verlet skin so neighbor lists survive small motions.
+
+*/
+
+#if !defined(__CellList_h__)
+#define __CellList_h__
+
+#include <vector>
+#include <cmath>
+
+namespace voom
+{
+
+  /*!  Uniform-grid (cell list) neighbor builder.  Like NodeBin, points
+    are binned into cells and only adjacent cells are searched, but
+    the grid is rebuilt from flat coordinate arrays, may be periodic
+    in any direction, and keeps Verlet candidate lists.
+
+    Candidates are all pairs closer than radius+skin when the grid was
+    last built.  They are only rebuilt once some point has moved more
+    than skin/2 since, so between rebuilds the exact neighbors within
+    the radius are found by filtering the candidates, in O(N) time.
+    With skin=0 every update() rebuilds.
+
+    Coordinates are passed as x0,y0,z0,x1,y1,z1,...
+  */
+  class CellList
+  {
+  public:
+
+    typedef std::vector<int> IndexContainer;
+
+    //! Construct for cutoff radius and Verlet skin
+    CellList(double radius, double skin=0.0)
+      : _radius(radius), _skin(skin), _built(false) {
+      for(int d=0; d<3; d++) _period[d] = -1.0;
+    }
+
+    //! Make direction d periodic with period length (<=0 to disable)
+    void setPeriodic(int d, double length) {
+      _period[d] = length;
+      _built = false;
+    }
+
+    //! Change the cutoff radius (forces a rebuild)
+    void setRadius(double radius) {
+      if(radius != _radius) _built = false;
+      _radius = radius;
+    }
+
+    //! Change the Verlet skin (forces a rebuild)
+    void setSkin(double skin) {
+      if(skin != _skin) _built = false;
+      _skin = skin;
+    }
+
+    double radius() const { return _radius; }
+    double skin() const { return _skin; }
+
+    //! Rebuild candidate lists if needed; returns true if rebuilt
+    bool update(const std::vector<double> & x);
+
+    //! True if points moved more than half the skin since last build
+    bool needsRebuild(const std::vector<double> & x) const;
+
+    //! Exact neighbor lists (j != i, |xi-xj| <= r) at current positions
+    /*! r must not exceed radius().  Calls update() first. */
+    void neighbors(const std::vector<double> & x, double r,
+		   std::vector< IndexContainer > & lists);
+
+    //! Exact unique pairs i<j with |xi-xj| <= r, as i0,j0,i1,j1,...
+    void pairs(const std::vector<double> & x, double r, IndexContainer & ij);
+
+    //! Distance with the minimum-image convention in periodic directions
+    double distance(const double * a, const double * b) const {
+      double r2 = 0.0;
+      for(int d=0; d<3; d++) {
+	double dx = a[d]-b[d];
+	if(_period[d] > 0.0) dx -= _period[d]*std::floor(dx/_period[d] + 0.5);
+	r2 += dx*dx;
+      }
+      return std::sqrt(r2);
+    }
+
+    //! Number of candidate pairs (each counted once)
+    int candidatePairs() const { return _candidates.size()/2; }
+
+  private:
+
+    double _radius;
+    double _skin;
+    double _period[3];
+    bool _built;
+
+    //! grid geometry
+    double _min[3];
+    double _cell[3];
+    int _n[3];
+
+    //! positions at last build
+    std::vector<double> _x0;
+
+    //! unique candidate pairs i<j, as i0,j0,i1,j1,...
+    IndexContainer _candidates;
+
+    //! bin points and collect candidate pairs
+    void _build(const std::vector<double> & x);
+
+    //! cell coordinate of point component
+    int _cellIndex(int d, double x) const;
+  };
+
+}; // namespace voom
+
+#endif // __CellList_h__
@@ -38,7 +38,43 @@ namespace voom
     //   _dof+=(*n)->dof();
     // }
 
+    _springsOf.resize(Proteins.size());
+    for (uint i = 0; i < _harmonicConn.size(); i++)
+    {
+      _springsOf[_harmonicConn[i][0]].push_back(i);
+      _springsOf[_harmonicConn[i][1]].push_back(i);
+    }
+
   }; // ProteinBody constructor
+
+
+
+  double HarmonicProteinBody::localEnergy(ProteinNode * A)
+  {
+    double W = ProteinBody::localEnergy(A);
+
+    const vector<int > & springs = _springsOf[index(A)];
+    for (uint k = 0; k < springs.size(); k++)
+    {
+      ProteinNode * P = _proteins[_harmonicConn[springs[k]][0]];
+      ProteinNode * Q = _proteins[_harmonicConn[springs[k]][1]];
+      double r = P->getDistance(Q);
+      W += 0.5*_harmonicStrength*(r - _rHarmonic)*(r - _rHarmonic);
+    }
+    return W;
+  };
+
+
+
+  void HarmonicProteinBody::coupledProteins(uint i, vector<uint> & coupled)
+  {
+    ProteinBody::coupledProteins(i, coupled);
+    for (uint k = 0; k < _springsOf[i].size(); k++)
+    {
+      const vector<int > & spring = _harmonicConn[_springsOf[i][k]];
+      coupled.push_back(spring[0] == int(i) ? spring[1] : spring[0]);
+    }
+  };
 	  
 
   
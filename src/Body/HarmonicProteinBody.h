@@ -47,6 +47,12 @@ namespace voom
     //! Do mechanics on Body
     void compute( bool f0, bool f1, bool f2 );
 
+    //! Pair terms of ProteinBody plus the springs attached to A
+    double localEnergy(ProteinNode * A);
+
+    //! Neighbors of protein i plus its spring partners
+    void coupledProteins(uint i, vector<uint> & coupled);
+
   private:
 
     // Springs positions
@@ -58,6 +64,9 @@ namespace voom
     // Spring equilibrium distance
     double _rHarmonic;
 
+    // Springs attached to each protein (indices into _harmonicConn)
+    vector<vector<int > > _springsOf;
+
 #ifdef WITH_MPI
     int _processorRank;
     int _nProcessors;
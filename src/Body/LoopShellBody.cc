@@ -313,7 +313,7 @@ namespace voom
   void LoopShellBody<Material_t>::compute( bool f0, bool f1, bool f2 )
   { 
     
-//     if(f2) _computeStiffness();
+    if(f2 && _fdStiffness) _computeStiffness();
 
     int eBegin=0, eEnd=_elements.size();
     int sBegin=0, sEnd=_shells.size();
@@ -475,14 +475,20 @@ namespace voom
     // compute energy, forces and stiffness matrix in each element
     // loop through all elements
 
+    // elements of one color share no nodes, so their force
+    // accumulation does not contend
+    const ColorContainer & colors = elementColors();
+    for(int c=0; c<colors.size(); c++) {
+      const std::vector<int> & batch = colors[c];
 #ifdef _OPENMP	
 #pragma omp parallel for 		\
   schedule(static) default(shared) 
 #endif	
-    for(int ei=eBegin; ei<eEnd; ei++) {
-	if( !_active[ei] ) continue;
-//       Element* e=_elements[ei];
-	  _elements[ei]->compute( f0, f1, f2 );
+      for(int b=0; b<batch.size(); b++) {
+	const int ei = batch[b];
+	if( ei<eBegin || ei>=eEnd || !_active[ei] ) continue;
+	_elements[ei]->compute( f0, f1, f2 );
+      }
     }
 
     if(f0) { 
@@ -538,59 +544,114 @@ namespace voom
   }           
 
 
-  //! compute stiffness
+  //! color shell nodes so that no two nodes of a color share a shell
   template< class Material_t >
-  void LoopShellBody<Material_t>::_computeStiffness()
+  void LoopShellBody<Material_t>::_colorNodes()
   { 
-    // build table of elements connected to each node 
-    std::vector< std::vector< FeElement_t* > > elementMap;
-    elementMap.resize(_shellNodes.size());
+    const int nNodes = _shellNodes.size();
+    _nodeColors.clear();
+    _colorShells.clear();
+    _nodeShells.assign(nNodes, std::vector<int>());
+
+    // shells (patches) supported by each node
     for(int si=0; si<_shells.size(); si++) {
-	if( !_active[si] ) continue;
-	FeElement_t* s=_shells[si];
+      if( !_active[si] ) continue;
+      FeElement_t* s=_shells[si];
+      for(int ni=0; ni<s->nodes().size(); ni++) 
+	_nodeShells[ s->nodes()[ni]->id() ].push_back( si );
+    }
+
+    // greedy distance-2 coloring: a node takes the lowest color not
+    // used by any node of the patches it belongs to
+    std::vector<int> color(nNodes, -1);
+    std::vector<int> mark;
+    for(int a=0; a<nNodes; a++) {
+      const int id = _shellNodes[a]->id();
+      mark.assign(_nodeColors.size(), -1);
+      for(int k=0; k<_nodeShells[id].size(); k++) {
+	FeElement_t* s=_shells[ _nodeShells[id][k] ];
 	for(int ni=0; ni<s->nodes().size(); ni++) {
-	  FeNode_t * n = s->nodes()[ni];
-	  elementMap[ n->id() ].push_back( s );
+	  const int c = color[ s->nodes()[ni]->id() ];
+	  if(c >= 0) mark[c] = a;
 	}
+      }
+      int c = 0;
+      while(c < _nodeColors.size() && mark[c] == a) c++;
+      if(c == _nodeColors.size()) {
+	_nodeColors.push_back( std::vector<int>() );
+	_colorShells.push_back( std::vector<int>() );
+      }
+      color[id] = c;
+      _nodeColors[c].push_back(a);
+      _colorShells[c].insert(_colorShells[c].end(), 
+			     _nodeShells[id].begin(), _nodeShells[id].end());
     }
-    
-    //  perturb nodes to compute stiffness
-    for(int a=0; a<_shellNodes.size(); a++) {
-	FeNode_t * n = _shellNodes[a];
-	for(int i=0; i<3; i++) n->setStiffness(i,0.0);
-
-	const double h = 1.0e-6;
-
-	for(int i=0; i<3; i++) {
-	  compute(false,false,false); // for global geometry calculations
-	  n->setForce(i,0.0);
-
-	  // push point forward
-	  n->addPoint(i, h); 
-	  // compute and assemble element forces
-	  for(int e=0; e<elementMap[ n->id() ].size(); e++) {
-	    elementMap[ n->id() ][ e ]->compute(false,true,false);
-	  }
-	  double fia=n->getForce(i);
-	  
-	  n->setForce(i,0.0);
+    _coloredShells = 0;
+    for(int si=0; si<_shells.size(); si++) if( _active[si] ) _coloredShells++;
+  }
 
+  //! compute stiffness
+  template< class Material_t >
+  void LoopShellBody<Material_t>::_computeStiffness()
+  { 
+    // Nodes of one color share no shell, so a shell computed after
+    // perturbing every node of a color sees exactly one perturbed
+    // node, and the force change at each node is due to its own
+    // perturbation only.  All nodes of a color are then differenced
+    // at once: 6 shell sweeps per color, O(N) overall.
+    int nActive = 0;
+    for(int si=0; si<_shells.size(); si++) if( _active[si] ) nActive++;
+    if( _coloredShells != nActive ) _colorNodes();
+
+    // save forces, which are overwritten by the differencing
+    std::vector<double> savedForces;
+    for(ConstNodeIterator n=_nodes.begin(); n!=_nodes.end(); n++)
+      for(int i=0; i<(*n)->dof(); i++) savedForces.push_back( (*n)->getForce(i) );
+
+    compute(false,false,false); // for global geometry calculations
+
+    const double h = 1.0e-6;
+    std::vector<double> fp;
+    for(int c=0; c<_nodeColors.size(); c++) {
+      const std::vector<int> & nodes = _nodeColors[c];
+      const std::vector<int> & shells = _colorShells[c];
+      fp.resize(nodes.size());
+
+      for(int i=0; i<3; i++) {
+	// push points forward
+	for(int k=0; k<nodes.size(); k++) {
+	  _shellNodes[nodes[k]]->setForce(i,0.0);
+	  _shellNodes[nodes[k]]->addPoint(i, h);
+	}
+#ifdef _OPENMP	
+#pragma omp parallel for schedule(static) default(shared)
+#endif	
+	for(int e=0; e<shells.size(); e++) _shells[shells[e]]->compute(false,true,false);
+	for(int k=0; k<nodes.size(); k++) {
+	  fp[k] = _shellNodes[nodes[k]]->getForce(i);
+	  _shellNodes[nodes[k]]->setForce(i,0.0);
 	  // push point backward
-	  n->addPoint(i, -h-h); 
-	  // compute and assemble element forces
-	  for(int e=0; e<elementMap[ n->id() ].size(); e++) {
-	    elementMap[ n->id() ][ e ]->compute(false,true,false);
-	  }
-	  fia-=n->getForce(i);
-
-	  fia /= 2.0*h;
-	  n->setStiffness(i,fia);
-	  
+	  _shellNodes[nodes[k]]->addPoint(i, -h-h);
+	}
+#ifdef _OPENMP	
+#pragma omp parallel for schedule(static) default(shared)
+#endif	
+	for(int e=0; e<shells.size(); e++) _shells[shells[e]]->compute(false,true,false);
+	for(int k=0; k<nodes.size(); k++) {
+	  FeNode_t * n = _shellNodes[nodes[k]];
+	  n->addStiffness(i, (fp[k] - n->getForce(i))/(2.0*h));
 	  // return point
-	  n->addPoint(i, -h-h); 
+	  n->addPoint(i, h); 
 	  n->setForce(i,0.0);
 	}
-      }    
+      }
+    }
+
+    compute(false,false,false); // restore global geometry
+
+    int k=0;
+    for(ConstNodeIterator n=_nodes.begin(); n!=_nodes.end(); n++)
+      for(int i=0; i<(*n)->dof(); i++) (*n)->setForce(i, savedForces[k++]);
   }
 
   //! create input file used by Paraview, a 3D viewer
@@ -1417,6 +1478,7 @@ namespace voom
     }
 
     delete mesh;
+    connectivityChanged();
 
     clock_t t2=clock();
     std::cout << "Done building elements.  Elapsed time: "
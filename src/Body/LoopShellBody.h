@@ -75,7 +75,7 @@ namespace voom
     typedef std::vector<ElementConnectivity> ConnectivityContainer;
 
     //! Default Constructor
-    LoopShellBody() {;}
+    LoopShellBody() : _fdStiffness(false), _coloredShells(-1) {;}
 
     //! Construct from stuff
     LoopShellBody(Material_t material,
@@ -90,7 +90,8 @@ namespace voom
 		  const double penaltyTotalCurvature= 1.0e4,
 		  GlobalConstraint volumeConstraint = noConstraint,
 		  GlobalConstraint areaConstraint = noConstraint,
-		  GlobalConstraint totalCurvatureConstraint = noConstraint ) {
+		  GlobalConstraint totalCurvatureConstraint = noConstraint )
+      : _fdStiffness(false), _coloredShells(-1) {
 
       initializeBody(material, connectivities, nodes, quadOrder, 
 		     pressure, tension, totalCurvatureForce,
@@ -142,6 +143,10 @@ namespace voom
     double prescribedArea() const { return _prescribedArea; }
     void setPrescribedArea(double A) { _prescribedArea = A; }
 
+    //! Assemble the finite-difference diagonal stiffness when compute() is
+    //! called with f2 (off by default)
+    void setFiniteDifferenceStiffness(bool fd) { _fdStiffness = fd; }
+
     double totalCurvature() const { return _totalCurvature;}
     double prescribedTotalCurvature() const { return _prescribedTotalCurvature;}
     
@@ -342,8 +347,22 @@ namespace voom
 #endif
     
     // Compute the diagonal elements of the stiffness matrix by
-    // numerical differentiation
+    // numerical differentiation of colored groups of nodes
     void _computeStiffness();
+
+    // Build _nodeColors and _colorShells from the shell patches
+    void _colorNodes();
+
+    // Shell node indices of each color; no two share a shell
+    std::vector< std::vector<int> > _nodeColors;
+    // Shells touched by the nodes of each color
+    std::vector< std::vector<int> > _colorShells;
+    // Shells supported by each node (by node id)
+    std::vector< std::vector<int> > _nodeShells;
+    // Whether compute(f2=true) runs _computeStiffness()
+    bool _fdStiffness;
+    // Number of active shells when the coloring was built
+    int _coloredShells;
     
   };  
 } // namespace voom
@@ -24,8 +24,9 @@
 namespace voom
 {
   PotentialBody::PotentialBody(Potential * Mat,const vector<DeformationNode<3> * > & DefNodes,
-                 	       double SearchR):
-	_mat(Mat), _defNodes(DefNodes), _searchR(SearchR) 
+                 	       double SearchR, double Skin):
+	_mat(Mat), _defNodes(DefNodes), _searchR(SearchR), _cells(SearchR, Skin),
+	_pairList(false)
   {
     
 #ifdef WITH_MPI
@@ -42,44 +43,50 @@ namespace voom
     // Initialize material objects
     _elementVector.reserve(_defNodes.size());
 
+    vector< set<DeformationNode<3> *> > domains;
+    _findNeighbors(domains);
     for(uint i =0; i < _defNodes.size(); i++)
     {
-      Vector3D CenterNode = _defNodes[i]->point();
-      set<DeformationNode<3> *> domain;
-      // Find neighbors of CenterNode
-      for(uint j = 0; j < _defNodes.size(); j++)
-      {
-	if( tvmet::norm2(CenterNode - _defNodes[j]->point()) <= _searchR && i != j) {
-	  domain.insert(_defNodes[j]);
-	}
-      }
       // Build potential element
-      PotentialElement * el = new PotentialElement(_mat, _defNodes[i], domain);
+      PotentialElement * el = new PotentialElement(_mat, _defNodes[i], domains[i]);
       _elementVector.push_back(el);
     }
 
   }; // PotentialBody constructor
 
 
+
+  void PotentialBody::_findNeighbors(vector< set<DeformationNode<3> *> > & domains) {
+    vector<double> x(3*_defNodes.size());
+    for(uint i = 0; i < _defNodes.size(); i++)
+      for(int d = 0; d < 3; d++) x[3*i+d] = _defNodes[i]->point()(d);
+
+    vector< vector<int> > lists;
+    _cells.setRadius(_searchR);
+    _cells.neighbors(x, _searchR, lists);
+
+    domains.assign(_defNodes.size(), set<DeformationNode<3> *>());
+    for(uint i = 0; i < _defNodes.size(); i++)
+      for(uint k = 0; k < lists[i].size(); k++)
+	domains[i].insert(_defNodes[lists[i][k]]);
+
+    if(_pairList) _cells.pairs(x, _searchR, _pairs);
+    else _pairs.clear();
+  }
+
+
   
   void PotentialBody::recomputeNeighbors(const double searchR) {
     _searchR = searchR;
-    
+
+    vector< set<DeformationNode<3> *> > domains;
+    _findNeighbors(domains);
     for(uint i =0; i < _defNodes.size(); i++)
     {
-      Vector3D CenterNode = _defNodes[i]->point();
-      set<DeformationNode<3> *> domain;
-      // Find neighbors of CenterNode
-      for(uint j = 0; j < _defNodes.size(); j++)
-      {
-	if( tvmet::norm2(CenterNode - _defNodes[j]->point()) <= _searchR && i != j) {
-	  domain.insert(_defNodes[j]);
-	}
-      }
       // Modify domain of each element
-      _elementVector[i]->resetDomain(domain);
-
+      _elementVector[i]->resetDomain(domains[i]);
     }
+    connectivityChanged();
     
   };
   
@@ -90,13 +97,74 @@ namespace voom
   {
     // Initialize energy to be zero
     if(f0) _energy = 0.0;
+
+    double energy = 0.0;
+
+    if(_pairList) {
+      // Each pair once, weighted as it is counted by both elements.
+      // Every thread gathers separations for a contiguous block of
+      // pairs, runs the pair kernel on it and scatters the forces.
+      const int nPairs = _pairs.size()/2;
+      if(nPairs == 0) return;
+      _dx.resize(3*nPairs);
+      _r.resize(nPairs);
+      _W.resize(nPairs);
+      _F.resize(nPairs);
+
+#ifdef _OPENMP
+#pragma omp parallel default(shared) reduction(+:energy)
+#endif
+      {
+	int begin = 0, end = nPairs;
+#ifdef _OPENMP
+	const int nThreads = omp_get_num_threads(), thread = omp_get_thread_num();
+	begin = (static_cast<long>(nPairs)*thread)/nThreads;
+	end = (static_cast<long>(nPairs)*(thread+1))/nThreads;
+#endif
+	for (int p = begin; p < end; p++)
+	{
+	  const DeformationNode<3>::Point & xA = _defNodes[_pairs[2*p]]->point();
+	  const DeformationNode<3>::Point & xB = _defNodes[_pairs[2*p+1]]->point();
+	  double r2 = 0.0;
+	  for (int d = 0; d < 3; d++) {
+	    _dx[3*p+d] = xA(d) - xB(d);
+	    r2 += _dx[3*p+d]*_dx[3*p+d];
+	  }
+	  _r[p] = sqrt(r2);
+	}
+
+	if(end > begin)
+	  _mat->pairKernel(end-begin, &_r[0]+begin,
+			   (f0 ? &_W[0]+begin : 0), (f1 ? &_F[0]+begin : 0));
+
+	for (int p = begin; p < end; p++)
+	{
+	  if(f0) energy += 2.0*_W[p];
+	  if(f1) {
+	    Vector3D ForceIncrement(0.0);
+	    for (int d = 0; d < 3; d++) ForceIncrement(d) = 2.0*_F[p]*_dx[3*p+d];
+	    _defNodes[_pairs[2*p]]->updateForce(ForceIncrement);
+	    ForceIncrement = -ForceIncrement;
+	    _defNodes[_pairs[2*p+1]]->updateForce(ForceIncrement);
+	  }
+	}
+      }
+      if(f0) _energy += energy;
+      return;
+    }
     
-    // Loop over material objects
-    for (uint i = 0; i < _elementVector.size(); i++)
+    // Loop over material objects; elements share nodes, but the pair
+    // kernel is stateless and nodal force updates are atomic
+    const int nElements = _elementVector.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) default(shared) reduction(+:energy)
+#endif
+    for (int i = 0; i < nElements; i++)
     {
       _elementVector[i]->compute(f0, f1, f2);
-      _energy += _elementVector[i]->energy();
+      energy += _elementVector[i]->energy();
     }
+    _energy += energy;
 
     return;
   };
@@ -13,6 +13,7 @@
 #include <blitz/array.h>
 #include <vector>
 #include <map>
+#include <set>
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
@@ -22,6 +23,7 @@
 #include <cstdlib>
 #include <ctime>
 #include "Body.h"
+#include "CellList.h"
 #include "Potential.h"
 #include "PotentialElement.h"
 #include "voom.h"
@@ -45,8 +47,12 @@ namespace voom
   {
   public:
     //! Construct body from material, nodes, volumes, and LME parameters
+    /*! Neighbors within SearchR are found with a cell list; a
+      positive Skin keeps Verlet candidate lists so that
+      recomputeNeighbors() only rebins after large motions.
+    */
     PotentialBody(Potential * Mat,const vector<DeformationNode<3> * > & DefNodes,
-		  double SearchR);
+		  double SearchR, double Skin = 0.0);
 
     
     //! Destructor
@@ -61,6 +67,18 @@ namespace voom
 
     void recomputeNeighbors(double searchR);
 
+    //! Evaluate each unordered pair once from a flat pair list
+    /*! With full neighbor lists every pair (i,j) belongs to the
+      elements of both i and j, so it is evaluated twice and counted
+      twice in the energy and forces.  The pair list evaluates it once
+      with weight 2, giving the same energy and forces at half the
+      cost.  Elements are kept up to date in either mode.
+    */
+    void setPairList(bool pairList) { _pairList = pairList; recomputeNeighbors(_searchR); }
+
+    //! Number of unique interacting pairs
+    int numberOfPairs() const { return _pairs.size()/2; }
+
     //! Return the energy of the body
     double totalStrainEnergy() const { return _energy; };
     
@@ -88,6 +106,20 @@ namespace voom
     // Search radius
     double _searchR;
 
+    // Neighbor search grid
+    CellList _cells;
+
+    // Pair-list mode and unique pairs i<j stored as i0,j0,i1,j1,...
+    bool _pairList;
+    vector<int> _pairs;
+
+    // Per-pair separations (flat x,y,z), distances, energies and force
+    // factors for the batched pair kernel
+    vector<double> _dx, _r, _W, _F;
+
+    //! Neighbor sets of every node within _searchR
+    void _findNeighbors(vector< set<DeformationNode<3> *> > & domains);
+
 #ifdef WITH_MPI
     int _processorRank;
     int _nProcessors;
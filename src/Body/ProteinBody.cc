@@ -23,8 +23,8 @@
 
 namespace voom
 {
-  ProteinBody::ProteinBody(vector<ProteinNode *> & Proteins, ProteinPotential * Mat, double SearchR, double Pressure):
-    _proteins(Proteins), _mat(Mat), _searchR(SearchR), _pressure(Pressure)
+  ProteinBody::ProteinBody(vector<ProteinNode *> & Proteins, ProteinPotential * Mat, double SearchR, double Pressure, double Skin):
+    _proteins(Proteins), _mat(Mat), _searchR(SearchR), _pressure(Pressure), _cells(SearchR, Skin)
   {
     
 #ifdef WITH_MPI
@@ -37,50 +37,75 @@ namespace voom
     // for(ConstNodeIterator n = _nodes.begin(); n != _nodes.end(); n++) {
     //   _dof+=(*n)->dof();
     // }
+
+    // Periodic BC are along Z (see ProteinNode::getDistance)
+    if(Proteins.size() > 0 && Proteins[0]->getLength() > 0.0)
+      _cells.setPeriodic(2, Proteins[0]->getLength());
     
     // Initialize protein objects
-    for(uint i = 0; i < Proteins.size(); i++)
-    {
-      ProteinNode * A = Proteins[i];
-      vector<ProteinNode *> domain;
-      // Find neighbors of A
-      for(uint j = 0; j < Proteins.size(); j++)
-      {
-	if( i != j && A->getDistance(Proteins[j]) <= _searchR) {
-	  domain.push_back(Proteins[j]);
-	}
-      }
-      
-      _prElements.push_back(domain);
-    }
+    _findNeighbors();
 
   }; // ProteinBody constructor
 
 
+
+  void ProteinBody::_findNeighbors() {
+    vector<double> x(3*_proteins.size());
+    for(uint i = 0; i < _proteins.size(); i++) {
+      DeformationNode<3>::Point a = _proteins[i]->getHostPosition();
+      for(int d = 0; d < 3; d++) x[3*i+d] = a(d);
+    }
+
+    vector< vector<int> > lists;
+    _cells.setRadius(_searchR);
+    _cells.neighbors(x, _searchR, lists);
+
+    _prElements.resize(_proteins.size());
+    _index.clear();
+    for(uint i = 0; i < _proteins.size(); i++) {
+      _index[_proteins[i]] = i;
+      vector<ProteinNode *> & domain = _prElements[i];
+      domain.clear();
+      for(uint k = 0; k < lists[i].size(); k++)
+	domain.push_back(_proteins[lists[i][k]]);
+    }
+  }
+
+
   
   void ProteinBody::recomputeNeighbors(const double searchR) {
     _searchR = searchR;
-
-    // Initialize protein objects
-    for(uint i = 0; i < _proteins.size(); i++)
-    {
-      ProteinNode * A = _proteins[i];
-      vector<ProteinNode *> domain;
-      // Find neighbors of A
-      for(uint j = 0; j < _proteins.size(); j++)
-      {
-	if( i != j && A->getDistance(_proteins[j]) <= _searchR) {
-	  domain.push_back(_proteins[j]);
-	}
-      }
-      
-      _prElements[i] = domain;
-    }
-    
+    _findNeighbors();
+    connectivityChanged();
   };
   
 	  
   
+  double ProteinBody::localEnergy(ProteinNode * A)
+  {
+    const vector<ProteinNode *> & domain = _prElements[index(A)];
+    double W = 0.0;
+    for (uint j = 0; j < domain.size(); j++)
+    {
+      W += _mat->computeEnergy(A, domain[j]) + _mat->computeEnergy(domain[j], A);
+    }
+    return W;
+  };
+
+
+
+  double ProteinBody::deltaEnergy(ProteinNode * A, DeformationNode<3> * NewHost)
+  {
+    DeformationNode<3> * OldHost = A->getHost();
+    const double W0 = localEnergy(A);
+    A->setHost(NewHost);
+    const double W1 = localEnergy(A);
+    A->setHost(OldHost);
+    return W1 - W0;
+  };
+
+
+
   //! Compute E0, E1, E2
   void ProteinBody::compute( bool f0, bool f1, bool f2 )
   {
@@ -20,9 +20,11 @@
 #include <fstream>
 #include <cstdio>
 #include <cstdlib>
+#include <cassert>
 #include <ctime>
 
 #include "Body.h"
+#include "CellList.h"
 #include "ProteinPotential.h"
 #include "voom.h"
 #include "Node.h"
@@ -39,7 +41,12 @@ namespace voom
   class ProteinBody : public Body
   {
   public:
-    ProteinBody(vector<ProteinNode *> & Proteins, ProteinPotential * Mat, double SearchR, double Pressure = 0.0);
+    /*! Neighbors within SearchR are found with a cell list (periodic
+      in Z if the proteins are); a positive Skin keeps Verlet
+      candidate lists so that recomputeNeighbors() only rebins after
+      large motions.
+    */
+    ProteinBody(vector<ProteinNode *> & Proteins, ProteinPotential * Mat, double SearchR, double Pressure = 0.0, double Skin = 0.0);
     
     //! Destructor
     ~ProteinBody() {};
@@ -51,6 +58,40 @@ namespace voom
     
     void recomputeNeighbors(double searchR);
 
+    //! Sum of all energy terms that involve protein A
+    /*! Neighbor lists are symmetric, so these are the terms
+      W(A,B) and W(B,A) for every neighbor B of A.  Costs
+      O(neighbors) instead of the O(N) of a full compute().
+    */
+    virtual double localEnergy(ProteinNode * A);
+
+    //! Change of energy if A were moved to NewHost (A is not moved)
+    double deltaEnergy(ProteinNode * A, DeformationNode<3> * NewHost);
+
+    //! Move A to NewHost and update the energy by dE from deltaEnergy()
+    void commitMove(ProteinNode * A, DeformationNode<3> * NewHost, double dE) {
+      A->setHost(NewHost);
+      _energy += dE;
+    };
+
+    //! Position of A in the protein vector
+    uint index(ProteinNode * A) const {
+      map<ProteinNode *, uint>::const_iterator it = _index.find(A);
+      assert(it != _index.end());
+      return it->second;
+    };
+
+    //! Neighbors of protein i
+    const vector<ProteinNode* > & neighbors(uint i) const { return _prElements[i]; };
+
+    //! Indices of proteins sharing an energy term with protein i
+    /*! A move of protein i changes localEnergy() of exactly these. */
+    virtual void coupledProteins(uint i, vector<uint> & coupled) {
+      coupled.clear();
+      for(uint k = 0; k < _prElements[i].size(); k++)
+	coupled.push_back(index(_prElements[i][k]));
+    };
+
     void resetEquilibrium();
 
     ProteinPotential * getPotential() { return _mat; };
@@ -75,6 +116,15 @@ namespace voom
     // Pressure to be included when energy is computed
     double _pressure;
 
+    // Neighbor search grid
+    CellList _cells;
+
+    // Position of every protein in _proteins
+    map<ProteinNode *, uint> _index;
+
+    //! Neighbor lists of every protein within _searchR
+    void _findNeighbors();
+
 #ifdef WITH_MPI
     int _processorRank;
     int _nProcessors;
@@ -508,6 +508,24 @@ namespace voom
     
     FilGrid * _grid;
 
+    //! Interactions grouped so that no two of one color share a node
+    struct InteractionColoring {
+      ColorContainer colors;
+      //! number and summed generation() of the interactions colored
+      int size;
+      unsigned long generation;
+      InteractionColoring() : size(-1), generation(0) {}
+    };
+
+    InteractionColoring _crosslinkColors;
+    InteractionColoring _pinchColors;
+
+    //! Greedy node-disjoint coloring of es; rebuilt when interactions
+    //! are added or removed or one of them is moved (its generation()
+    //! changes)
+    template<class E>
+    const ColorContainer & interactionColors(const std::vector<E*> & es, InteractionColoring & coloring);
+
   };  
 } // namespace voom
 
@@ -0,0 +1,47 @@
+#include <vector>
+#include <iostream>
+#include <cstdlib>
+
+#include "CellList.h"
+
+using namespace std;
+using namespace voom;
+
+// Compare cell-list neighbors against an all-pairs search for a
+// random cloud that is periodic in Z and drifts between updates.
+int main(int argc, char* argv[])
+{
+  const int N = 2000;
+  const double L = 20.0, R = 1.5;
+  srand(1);
+
+  vector<double> x(3*N);
+  for(int i = 0; i < 3*N; i++) x[i] = L*rand()/RAND_MAX;
+
+  CellList cells(R, 0.4);
+  cells.setPeriodic(2, L);
+
+  int failures = 0, rebuilds = 0;
+  for(int step = 0; step < 10; step++) {
+    for(int i = 0; i < 3*N; i++) x[i] += 0.02*(2.0*rand()/RAND_MAX - 1.0);
+
+    if( cells.needsRebuild(x) ) rebuilds++;
+    vector< vector<int> > lists;
+    cells.neighbors(x, R, lists);
+
+    for(int i = 0; i < N; i++) {
+      vector<int> exact;
+      for(int j = 0; j < N; j++)
+	if( i != j && cells.distance(&x[3*i], &x[3*j]) <= R ) exact.push_back(j);
+      if(exact != lists[i]) failures++;
+    }
+  }
+
+  cout << "Rebuilds = " << rebuilds << " of 10 updates" << endl;
+  if(failures == 0) {
+    cout << "CellList test PASSED!" << endl;
+    return 0;
+  }
+  cout << "CellList test FAILED for " << failures << " lists!" << endl;
+  return 1;
+}
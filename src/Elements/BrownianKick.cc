@@ -15,6 +15,7 @@
 //----------------------------------------------------------------------
 
 
+#include <ctime>
 #include "VoomMath.h"
 #include "BrownianKick.h"
 
@@ -27,15 +28,20 @@ namespace voom
     : _nodes(defNodes), _Cd(Cd), _D(D), _dt(dt) {
     // seed random number generator
     _rng.seed((unsigned int)time(0));
+    _kicks = 0;
     // set the number of nodes
     _nodeCount = _nodes.size();
     _delta_xB.resize(_nodeCount);
   }
 
   void BrownianKick::updateKick(){
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
     for(int i=0; i < _nodeCount; i++){
-      Vector3D xi(_rng.random(),
-				     _rng.random(),_rng.random());
+      double z[4];
+      _rng.normal(_nodes[i]->id(), _kicks, z);
+      Vector3D xi(z[0], z[1], z[2]);
       _delta_xB[i] = xi*sqrt(_D*_dt);
 
       //Add the Brownian-kick to current coordinates of the nodes
@@ -43,6 +49,7 @@ namespace voom
 	_nodes[i]->addPoint(j,_delta_xB[i][j]);
       }
     }
+    _kicks++;
   }
 
   // Do mechanics on element; compute energy, forces, and/or stiffness.
@@ -19,7 +19,7 @@
 
 #include <blitz/array.h>
 #include <vector>
-#include <random/normal.h>
+#include "RandomStream.h"
 #include "Node.h"
 #include "Element.h"
 
@@ -53,6 +53,9 @@ namespace voom
     //! Set the Brownian random displacements
     void updateKick();
 
+    //! Seed of the kicks; equal seeds give equal runs at any thread count
+    void setSeed(unsigned long long seed) { _rng.seed(seed); _kicks = 0; }
+
     //! Access the container of nodes
     const NodeContainer& nodes() const { return _nodes; }    
     
@@ -65,7 +68,9 @@ namespace voom
 
     int _nodeCount;
 
-    ranlib::NormalUnit<double> _rng;
+    //! kicks keyed by node id and kick number
+    CounterRandom _rng;
+    unsigned long long _kicks;
   };
 	
 } // namespace voom
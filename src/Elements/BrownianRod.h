@@ -2,10 +2,11 @@
 #if !defined(__BrownianRod_h__)
 #define __BrownianRod_h__
 
-#include<random/normal.h>
+#include<ctime>
 #include "Node.h"
 #include "Element.h"
 #include "VoomMath.h"
+#include "RandomStream.h"
 
 namespace voom
 {
@@ -37,6 +38,7 @@ namespace voom
 
       // seed random number generator
       _rng.seed((unsigned int)time(0));
+      _draws = 0;
 
     }
 
@@ -54,6 +56,7 @@ namespace voom
       
       // seed random number generator
       _rng.seed((unsigned int)time(0));
+      _draws = 0;
 
     }
 
@@ -88,8 +91,14 @@ namespace voom
       }
       
       if(f2) {
-	double fpara = sqrt( 2.0*_kT*_Dpara/_timeStep ) * _rng.random();
-	double fperp = sqrt( 2.0*_kT*_Dperp/_timeStep ) * _rng.random();
+	// noise keyed by the rod's nodes and the number of draws, so
+	// it does not depend on the order in which rods are computed
+	double xi[4];
+	const CounterRandom::Word stream =
+	  (CounterRandom::Word(_nodeA->id()) << 32) | CounterRandom::Word(_nodeB->id());
+	_rng.normal(stream, _draws++, xi);
+	double fpara = sqrt( 2.0*_kT*_Dpara/_timeStep ) * xi[0];
+	double fperp = sqrt( 2.0*_kT*_Dperp/_timeStep ) * xi[1];
       /*       double fpara = sqrt( 2.0*_kT*_timeStep*_Mpara ) * _rng.random(); */
       /*       double fperp = sqrt( 2.0*_kT*_timeStep*_Mperp ) * _rng.random(); */
       
@@ -123,6 +132,9 @@ namespace voom
 
     void setViscosity(double v) { _viscosity = v; }
 
+    //! Seed of the noise; equal seeds give equal runs at any thread count
+    void setSeed(unsigned long long seed) { _rng.seed(seed); _draws = 0; }
+
     NodeContainer getNodes() { return _nodes;}
 
   private:
@@ -137,7 +149,8 @@ namespace voom
     double _timeStep;
     double _kT;
 
-    ranlib::NormalUnit<double> _rng;
+    CounterRandom _rng;
+    unsigned long long _draws;
  
    
   };
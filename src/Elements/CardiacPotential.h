@@ -15,6 +15,7 @@
 #include "Node.h"
 #include "NodeBase.h"
 #include "Element.h"
+#include "LuoRudyTable.h"
 #include <tvmet/Vector.h>
 #include <tvmet/Matrix.h>
 
@@ -152,7 +153,22 @@ namespace voom
     
     //! Do electrophysiology on element; compute current, voltage, etc.
     virtual void compute_v(double istim);
+    /*! Advances the gates with the Rush-Larsen scheme using the rate
+      table LuoRudyTable::shared(dt), on the element's gate state
+      arrays.  The state is only advanced if rk2 is true; otherwise
+      the ionic current is evaluated for the trial state. */
     virtual void compute_ion(double dt,double istim, bool rk2);
+
+    //! Reaction stage of operator splitting (see CardiacSplitStepper)
+    /*! Advances the quad point voltages and gates over
+      substeps*table.timeStep(); f returns the element's contribution
+      to the nodal voltage change times capacitance.  Returns the
+      largest quad point voltage change. */
+    double compute_reaction(const LuoRudyTable & table, int substeps,
+			    double istim, std::vector<double> & f);
+
+    //! Diffusion stage of operator splitting: f = -K V for the element
+    void compute_diffusion(std::vector<double> & f) const;
     float compute_ECG(tvmet::Vector<int,3>);
 
     virtual void computeLumpedCapacitance();
@@ -167,6 +183,12 @@ namespace voom
     //! Access the container of nodes
     InternalNodeContainer& internalNodes() { return _iNodes; }
 
+    //! Copy the gate state from the internal nodes (after changing them)
+    void loadInternalNodes();
+
+    //! Copy the gate state to the internal nodes (e.g. for output)
+    void storeInternalNodes();
+
     //! Structure to hold together everything needed at a quad point
     /*! Stuff needed at each quad point includes the quad weight,
       shape functions and their derivatives evaluated at the point,
@@ -199,6 +221,18 @@ namespace voom
     StiffnessMatrix _stiffness;
     double _ECG;
 
+    //! Rush-Larsen step of quad point q, returns -I_ion
+    double _reactionStep(const LuoRudyTable & table, int q,
+			 double istim, bool commit);
+
+    //! Gate state of all quad points, _state[k*Q+q] for variable k
+    //! (internal node index 0-7) at quad point q
+    std::vector<double> _state;
+
+    //! scratch for compute_ion: nodal voltages, quad point currents
+    std::vector<double> _vn;
+    std::vector<double> _current;
+
   };
 	
 } // namespace voom
@@ -0,0 +1,284 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                    HoHai Van and William S. Klug
+//                University of California Los Angeles
+//                    (C) 2006 All Rights Reserved
+//
+//----------------------------------------------------------------------
+
+/*!
+  \file CardiacSplitStepper.h
+
+  \brief Operator split, multirate time stepping of CardiacPotential
+  elements.
+
+*/
+
+#if !defined(__CardiacSplitStepper_h__)
+#define __CardiacSplitStepper_h__
+
+#include <vector>
+#include <map>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <iostream>
+#include "LuoRudyTable.h"
+
+namespace voom
+{
+
+  /*!  Advances the monodomain equation for a mesh of CardiacPotential
+    elements by Lie splitting.  Every macro step of length dt has two
+    stages:
+    <ol>
+    <li> Reaction: each element integrates its quad point ionic
+    models (CardiacPotential::compute_reaction) and the voltage change
+    is projected onto the nodes with the lumped capacitance.
+    <li> Diffusion: an explicit step V += dt C^{-1} (-K V), assembled
+    from CardiacPotential::compute_diffusion.
+    </ol>
+
+    The reaction stage is multirate.  An active element (on the
+    wavefront, or stimulated) takes 1, 2, 4, ... maxSubsteps substeps
+    so that the quad point voltages change by about dvSubstep per
+    substep.  A quiescent element (resting or in a slow plateau) is
+    only integrated every quiescentStride macro steps, in one step
+    covering all of them, and is woken as soon as one of its nodal
+    voltages has changed by more than dvQuiet since its last update or
+    it is stimulated; the reference voltages are taken after the
+    element's own reaction increment, so it is not woken by itself.
+    Since most of a large (e.g. fibrotic) tissue is
+    at rest most of the time, most elements cost one table lookup per
+    quad point every quiescentStride steps.  Quiescent steps use
+    forward Euler for the voltage, so quiescentStride*dt must remain
+    below about 2 ms.
+
+    Both stages loop over elements in parallel; each element writes
+    its nodal contributions to a buffer of its own and the nodes
+    gather them, so no two threads update the same node.
+  */
+  template< class Element_t >
+  class CardiacSplitStepper
+  {
+  public:
+
+    typedef typename Element_t::Node_t Node_t;
+
+    CardiacSplitStepper(const std::vector<Element_t*> & elements,
+			const std::vector<Node_t*> & nodes,
+			double dt, int maxSubsteps=8, int quiescentStride=8,
+			double dvSubstep=1.0, double dvQuiet=0.05);
+
+    //! Stimulus current of element e (0 for none)
+    void setStimulus(int e, double istim) { _istim[e] = istim; }
+
+    void clearStimulus() { std::fill(_istim.begin(), _istim.end(), 0.0); }
+
+    //! Advance by one macro step dt
+    void step();
+
+    double time() const { return _time; }
+
+    double timeStep() const { return _dt; }
+
+    //! Number of elements currently on the fast (active) path
+    int activeElements() const;
+
+    //! Element reaction updates and reaction substeps since construction
+    long reactionUpdates() const { return _updates; }
+    long reactionSubsteps() const { return _substeps; }
+
+  private:
+
+    std::vector<Element_t*> _elements;
+    std::vector<Node_t*> _nodes;
+
+    double _dt;
+    int _maxSubsteps, _stride;
+    double _dvSubstep, _dvQuiet;
+    double _time;
+
+    //! rate tables for dt/2^k and m*dt
+    std::vector<LuoRudyTable> _fine;
+    std::vector<LuoRudyTable> _coarse;
+
+    //! node-to-element incidence: (element, local node) pairs of node i
+    //! in [_incidenceStart[i], _incidenceStart[i+1])
+    std::vector<int> _incidenceStart;
+    std::vector< std::pair<int,int> > _incidence;
+
+    //! per element state of the scheduler
+    std::vector< std::vector<double> > _f;
+    std::vector< std::vector<double> > _vLast;
+    std::vector<double> _istim;
+    std::vector<int> _pending;
+    std::vector<int> _level;
+    std::vector<char> _quiescent;
+    std::vector<char> _updated;
+
+    long _updates, _substeps;
+
+    //! V_i += scale * sum of element contributions / C_i
+    void _gather(double scale, bool all);
+  };
+
+
+
+  template< class Element_t >
+  CardiacSplitStepper<Element_t>::
+  CardiacSplitStepper(const std::vector<Element_t*> & elements,
+		      const std::vector<Node_t*> & nodes,
+		      double dt, int maxSubsteps, int quiescentStride,
+		      double dvSubstep, double dvQuiet)
+    : _elements(elements), _nodes(nodes), _dt(dt),
+      _maxSubsteps(std::max(maxSubsteps,1)), _stride(std::max(quiescentStride,1)),
+      _dvSubstep(dvSubstep), _dvQuiet(dvQuiet), _time(0.0),
+      _updates(0), _substeps(0)
+  {
+    // tables for all substep and stride lengths
+    for(int n=1; n<=_maxSubsteps; n*=2) {
+      _fine.push_back(LuoRudyTable());
+      _fine.back().build(_dt/n);
+    }
+    _coarse.resize(_stride+1);
+    for(int m=2; m<=_stride; m++) _coarse[m].build(m*_dt);
+
+    // node incidence
+    std::map<Node_t*,int> index;
+    for(int i=0; i<_nodes.size(); i++) index[_nodes[i]] = i;
+    const int E = _elements.size();
+    std::vector< std::vector< std::pair<int,int> > > incident(_nodes.size());
+    for(int e=0; e<E; e++) {
+      const typename Element_t::VoltageNodeContainer & en = _elements[e]->voltageNodes();
+      for(int a=0; a<en.size(); a++) {
+	typename std::map<Node_t*,int>::const_iterator i = index.find(en[a]);
+	if( i == index.end() ) {
+	  std::cout << "CardiacSplitStepper: element " << e
+		    << " has a node that is not in the node list." << std::endl;
+	  exit(0);
+	}
+	incident[i->second].push_back( std::make_pair(e,a) );
+      }
+    }
+    _incidenceStart.resize(_nodes.size()+1, 0);
+    for(int i=0; i<_nodes.size(); i++) {
+      _incidenceStart[i+1] = _incidenceStart[i] + incident[i].size();
+      _incidence.insert(_incidence.end(), incident[i].begin(), incident[i].end());
+    }
+
+    _f.resize(E);
+    _vLast.resize(E);
+    for(int e=0; e<E; e++) {
+      const typename Element_t::VoltageNodeContainer & en = _elements[e]->voltageNodes();
+      _vLast[e].resize(en.size());
+      for(int a=0; a<en.size(); a++) _vLast[e][a] = en[a]->getPoint(0);
+    }
+    _istim.assign(E, 0.0);
+    _pending.assign(E, 0);
+    _level.assign(E, 0);
+    _quiescent.assign(E, 0);
+    _updated.assign(E, 0);
+  }
+
+
+
+  template< class Element_t >
+  void CardiacSplitStepper<Element_t>::step() {
+    const int E = _elements.size();
+    long updates = 0, substeps = 0;
+
+    // reaction stage
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,64) reduction(+:updates,substeps)
+#endif
+    for(int e=0; e<E; e++) {
+      Element_t * el = _elements[e];
+      const typename Element_t::VoltageNodeContainer & en = el->voltageNodes();
+      std::vector<double> & vLast = _vLast[e];
+      _updated[e] = 0;
+      _pending[e]++;
+
+      double wake = 0.0;
+      for(int a=0; a<en.size(); a++)
+	wake = std::max(wake, std::abs(en[a]->getPoint(0) - vLast[a]));
+      const bool stimulated = ( _istim[e] != 0.0 );
+      if( _quiescent[e] && !stimulated && wake < _dvQuiet && _pending[e] < _stride ) continue;
+
+      const int m = _pending[e];
+      double activity;
+      if( m > 1 ) {
+	activity = el->compute_reaction(_coarse[m], 1, _istim[e], _f[e]);
+	substeps++;
+      } else {
+	const int n = 1 << _level[e];
+	activity = el->compute_reaction(_fine[_level[e]], n, _istim[e], _f[e]);
+	substeps += n;
+      }
+      updates++;
+      _pending[e] = 0;
+      _updated[e] = 1;
+
+      // classify for the next step
+      const double perStep = activity/m;
+      _quiescent[e] = ( !stimulated && perStep < _dvQuiet );
+      int level = 0;
+      while( level+1 < _fine.size() && perStep > _dvSubstep*(1 << level) ) level++;
+      _level[e] = level;
+    }
+    _updates += updates;
+    _substeps += substeps;
+    _gather(1.0, false);
+
+    // voltages seen by the updated elements, including their own
+    // reaction increment, so that only later changes wake them
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(int e=0; e<E; e++) {
+      if( !_updated[e] ) continue;
+      const typename Element_t::VoltageNodeContainer & en = _elements[e]->voltageNodes();
+      for(int a=0; a<en.size(); a++) _vLast[e][a] = en[a]->getPoint(0);
+    }
+
+    // diffusion stage
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(int e=0; e<E; e++) _elements[e]->compute_diffusion(_f[e]);
+    _gather(_dt, true);
+
+    _time += _dt;
+  }
+
+
+
+  template< class Element_t >
+  void CardiacSplitStepper<Element_t>::_gather(double scale, bool all) {
+    const int N = _nodes.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(int i=0; i<N; i++) {
+      double s = 0.0;
+      for(int k=_incidenceStart[i]; k<_incidenceStart[i+1]; k++) {
+	const int e = _incidence[k].first;
+	if( all || _updated[e] ) s += _f[e][_incidence[k].second];
+      }
+      if( s != 0.0 ) _nodes[i]->addPoint(0, scale*s/_nodes[i]->getCapacitance(0));
+    }
+  }
+
+
+
+  template< class Element_t >
+  int CardiacSplitStepper<Element_t>::activeElements() const {
+    int active = 0;
+    for(int e=0; e<_quiescent.size(); e++) if( !_quiescent[e] ) active++;
+    return active;
+  }
+
+}; // namespace voom
+
+#endif // __CardiacSplitStepper_h__
@@ -34,7 +34,7 @@ namespace voom
     typedef std::vector< Node_t*> Node_tContainer;
     typedef typename Node_tContainer::iterator Node_tIterator;
 
-    Crosslink(double k, PeriodicBox * box) : _k(k), _d0(0.0), _box(box) {
+    Crosslink(double k, PeriodicBox * box) : _k(k), _d0(0.0), _box(box), _generation(0) {
       int a = 0;
       int id = a;
       BrownianNode<2>::Point X;
@@ -56,7 +56,8 @@ namespace voom
     }
 
     Crosslink(Node_t * node1A, Node_t * node1B, Node_t * node2A, Node_t * node2B, double epsi1, double epsi2, double k, PeriodicBox * box, bool relaxed) 
-      : _node1A(node1A), _node1B(node1B), _node2A(node2A), _node2B(node2B), _epsi1(epsi1), _epsi2(epsi2), _k(k), _box(box) { 
+      : _node1A(node1A), _node1B(node1B), _node2A(node2A), _node2B(node2B), _epsi1(epsi1), _epsi2(epsi2), _k(k), _box(box), _generation(0) { 
+      setBaseNodes();
       //changed from const & to variables
       VectorND x1A = _node1A->point();
       VectorND x1B = _node1B->point();
@@ -103,6 +104,8 @@ namespace voom
       _node2B = node2B; 
       _epsi1 = epsi1; 
       _epsi2 = epsi2;
+      setBaseNodes();
+      _generation++;
 
       VectorND x1A = _node1A->point();
       VectorND x1B = _node1B->point();
@@ -118,7 +121,38 @@ namespace voom
  
     }
 
-    void compute(bool f0, bool f1, bool f2) {
+    void compute(bool f0, bool f1, bool f2) { _compute(f0,f1,f2,false); }
+
+    //! compute() for callers that make sure no other thread writes to
+    //! the filament nodes meanwhile; forces are added without atomics
+    void computeExclusive(bool f0, bool f1, bool f2) { _compute(f0,f1,f2,true); }
+
+    //! Incremented whenever setPosition() changes the filament nodes
+    unsigned int generation() const { return _generation; }
+
+    double stiffness() const {return _k;}
+
+    void setStiffness(double k) { _k = k; }
+
+    Node_tContainer getNodes(){
+      Node_tContainer nodes;
+      nodes.push_back(_node1);
+      nodes.push_back(_node2);
+      return nodes;
+    }
+
+    Node_t * getNode(int a) {
+      if(a==0) {
+	return _node1;
+      } else if(a==1) {
+	return _node2;
+      } else {
+	return 0;
+      }
+    }
+  private:
+
+    void _compute(bool f0, bool f1, bool f2, bool exclusive) {
 
       VectorND x1A = _node1A->point();
       VectorND x1B = _node1B->point();
@@ -149,36 +183,30 @@ namespace voom
       if(f1) {	
 	for(int i=0; i<N; i++) {
 	  double f = -_k*(d-_d0)*(dx(i))/d;
-	  _node1A->addForce(i, -f*(1.0-_epsi1));
-          _node1B->addForce(i, -f*_epsi1);
-          _node2A->addForce(i, f*(1.0-_epsi2));
-	  _node2B->addForce(i, f*_epsi2);
+	  if(exclusive) {
+	    _node1A->addForceExclusive(i, -f*(1.0-_epsi1));
+	    _node1B->addForceExclusive(i, -f*_epsi1);
+	    _node2A->addForceExclusive(i, f*(1.0-_epsi2));
+	    _node2B->addForceExclusive(i, f*_epsi2);
+	  } else {
+	    _node1A->addForce(i, -f*(1.0-_epsi1));
+	    _node1B->addForce(i, -f*_epsi1);
+	    _node2A->addForce(i, f*(1.0-_epsi2));
+	    _node2B->addForce(i, f*_epsi2);
+	  }
 	}
       }
       return;
     }
-    
-    double stiffness() const {return _k;}
-
-    void setStiffness(double k) { _k = k; }
-
-    Node_tContainer getNodes(){
-      Node_tContainer nodes;
-      nodes.push_back(_node1);
-      nodes.push_back(_node2);
-      return nodes;
-    }
 
-    Node_t * getNode(int a) {
-      if(a==0) {
-	return _node1;
-      } else if(a==1) {
-	return _node2;
-      } else {
-	return 0;
-      }
+    // the filament nodes the crosslink scatters forces into //
+    void setBaseNodes() {
+      _baseNodes.clear();
+      _baseNodes.push_back(_node1A);
+      _baseNodes.push_back(_node1B);
+      _baseNodes.push_back(_node2A);
+      _baseNodes.push_back(_node2B);
     }
-  private:
     
     Node_t * _node1;
     Node_t * _node2;
@@ -191,6 +219,7 @@ namespace voom
     double _k;
     double _d0;
     PeriodicBox * _box;
+    unsigned int _generation;
     
   };
 };
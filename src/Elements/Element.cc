@@ -43,6 +43,48 @@ extern "C" void dsyev_(char *jobz, char *uplo, int *n, double *a, int *lda,
 
 namespace voom {
 
+  void Element::stiffness(blitz::Array<double,2> & K) {
+    const int nDOF = baseDof();
+    K.resize(nDOF,nDOF);
+    K = 0.0;
+
+    // Nodal forces are shared with neighboring elements, so save them
+    // and compute forces of this element alone.
+    blitz::Array<double,1> f0(nDOF);
+    for(int a=0, ai=0; a<_baseNodes.size(); a++)
+      for(int i=0; i<_baseNodes[a]->dof(); i++, ai++)
+	f0(ai) = _baseNodes[a]->getForce(i);
+
+    for(int b=0, bj=0; b<_baseNodes.size(); b++) {
+      for(int j=0; j<_baseNodes[b]->dof(); j++, bj++) {
+	const double x = _baseNodes[b]->getPoint(j);
+	const double h = 1.0e-6*std::max(1.0, std::abs(x));
+
+	for(int s=1; s>=-1; s-=2) {
+	  for(int a=0; a<_baseNodes.size(); a++)
+	    for(int i=0; i<_baseNodes[a]->dof(); i++)
+	      _baseNodes[a]->setForce(i,0.0);
+	  _baseNodes[b]->setPoint(j, x+s*h);
+	  compute(false,true,false);
+	  for(int a=0, ai=0; a<_baseNodes.size(); a++)
+	    for(int i=0; i<_baseNodes[a]->dof(); i++, ai++)
+	      K(ai,bj) += s*_baseNodes[a]->getForce(i)/(2.0*h);
+	}
+	_baseNodes[b]->setPoint(j, x);
+      }
+    }
+
+    for(int a=0, ai=0; a<_baseNodes.size(); a++)
+      for(int i=0; i<_baseNodes[a]->dof(); i++, ai++)
+	_baseNodes[a]->setForce(i, f0(ai));
+
+    // symmetrize
+    for(int ai=0; ai<nDOF; ai++)
+      for(int bj=ai+1; bj<nDOF; bj++)
+	K(ai,bj) = K(bj,ai) = 0.5*(K(ai,bj) + K(bj,ai));
+    return;
+  }
+
   bool Element::checkConsistency() {
 
     srand(time(0));
@@ -86,6 +86,21 @@ namespace voom
     //! Do mechanics on element; compute energy, forces, and/or stiffness.
     virtual void compute(bool f0, bool f1, bool f2) = 0;
     
+    //! Element stiffness matrix, ordered by base node and nodal dof.
+    /*! The default implementation takes central differences of the
+      element forces, one base-node dof at a time.  Elements with
+      analytical second derivatives should override it.
+    */
+    virtual void stiffness(blitz::Array<double,2> & K);
+
+    //! Number of dof of all base nodes
+    int baseDof() const {
+      int n=0;
+      for(ConstBaseNodeIterator a=_baseNodes.begin(); a!=_baseNodes.end(); a++)
+	n += (*a)->dof();
+      return n;
+    }
+
     virtual bool checkConsistency();
 		
     //! Rank of the element stiffness matrix
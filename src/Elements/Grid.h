@@ -10,9 +10,11 @@
 #if !defined(__Grid_h__)
 #define __Grid_h__
 
+#include <algorithm>
 #include "VoomMath.h"
 #include "Node.h"
 #include "PeriodicBox.h"
+#include "LeesEdwards.h"
 
 using namespace std;
 using namespace voom;
@@ -34,6 +36,7 @@ namespace voom
     typedef typename ElemBoxes::iterator ElemBoxesIterator;
     typedef typename std::map<Elem*,ElemContainer> ElemPairContainer;
     typedef typename ElemPairContainer::iterator ElemPairIterator;
+    typedef typename std::vector< std::pair<int,int> > IndexPairList;
 
     typedef const VectorND & (PosClass::*PosFunc)();
 
@@ -310,6 +313,103 @@ namespace voom
       return tmpEC;
     }
     
+    // flat alternative to getNeighbors(): bins elems (by their index in the vector) into a
+    // cell list sorted by cell and returns each unordered pair (i<j) of elements in the same
+    // or adjacent cells exactly once.  Under Lees-Edwards shear the cells are laid out in the
+    // unsheared frame, so images across the sheared boundary land in the right cells; the
+    // neighbor stencil is widened along the shear direction to cover the cutoff. //
+    const IndexPairList & getNeighborPairs(const ElemList & elems) {
+      int nElems = elems.size();
+      int nCells = 1;
+      for(int i=0; i<N; i++) nCells *= _nBoxes[i];
+
+      const LeesEdwards* le = dynamic_cast<const LeesEdwards*>(_box);
+      const VectorND & size = _box->size();
+      int sd = 0;
+      double shear = 0.0;
+      if(le != 0) {
+	sd = le->shearDirection();
+	int od = 1-sd;
+	// any lattice-equivalent shear gives a valid cell; use the smallest one //
+	double period = size[sd]/size[od];
+	shear = le->shear() - floor(le->shear()/period+.5)*period;
+      }
+
+      // bin elements: counting sort by cell keeps indices ascending within each cell //
+      _elemCells.resize(nElems);
+      _cellStart.assign(nCells+1,0);
+      for(int e=0; e<nElems; e++) {
+	VectorND X;
+	X = (elems[e]->*getElemPos)();
+	if(le != 0) X[sd] += (sd==0 ? -shear : shear)*X[1-sd];
+	VectorNI ecoords;
+	for(int i=0; i<N; i++) {
+	  double x = fmod(X[i],size[i]);
+	  if(x < 0.0) x += size[i];
+	  ecoords[i] = std::min((int)(x/_gridSpace[i]),_nBoxes[i]-1);
+	}
+	_elemCells[e] = getBoxIndex(ecoords);
+	_cellStart[_elemCells[e]+1]++;
+      }
+      for(int c=0; c<nCells; c++) _cellStart[c+1] += _cellStart[c];
+      _cellElems.resize(nElems);
+      IndexList fill(_cellStart.begin(),_cellStart.end()-1);
+      for(int e=0; e<nElems; e++) {
+	_cellElems[fill[_elemCells[e]]++] = e;
+      }
+
+      // stencil reach per dimension; |dX_s| <= |dx_s| + |shear||dx_o| in the unsheared frame //
+      VectorNI reach;
+      for(int i=0; i<N; i++) reach[i] = 1;
+      if(le != 0) {
+	reach[sd] += (int)(ceil(fabs(shear)*_gridSpace[1-sd]/_gridSpace[sd]));
+      }
+      for(int i=0; i<N; i++) {
+	if(2*reach[i]+1 > _nBoxes[i]) reach[i] = _nBoxes[i]/2;
+      }
+
+      _indexPairs.clear();
+      IndexList nbrs;
+      for(int c=0; c<nCells; c++) {
+	if(_cellStart[c] == _cellStart[c+1]) continue;
+	VectorNI gcs;
+	getGridCoords(c,gcs);
+	nbrs.clear();
+	if(N==2) {
+	  for(int ix=-reach[0]; ix<=reach[0]; ix++) {
+	    for(int iy=-reach[1]; iy<=reach[1]; iy++) {
+	      VectorNI tmpInd;
+	      tmpInd[0] = ((gcs[0]+ix)%_nBoxes[0]+_nBoxes[0])%_nBoxes[0];
+	      tmpInd[1] = ((gcs[1]+iy)%_nBoxes[1]+_nBoxes[1])%_nBoxes[1];
+	      int nc = getBoxIndex(tmpInd);
+	      // each unordered pair of cells is visited once, from its lower index //
+	      if(nc >= c) nbrs.push_back(nc);
+	    }
+	  }
+	}
+	else {
+	  std::cerr << "Grid::getNeighborPairs: only 2D grids are supported." << std::endl;
+	  break;
+	}
+	std::sort(nbrs.begin(),nbrs.end());
+	nbrs.erase(std::unique(nbrs.begin(),nbrs.end()),nbrs.end());
+
+	for(int k=0; k<nbrs.size(); k++) {
+	  int nc = nbrs[k];
+	  for(int a=_cellStart[c]; a<_cellStart[c+1]; a++) {
+	    int ea = _cellElems[a];
+	    int b0 = (nc == c) ? a+1 : _cellStart[nc];
+	    for(int b=b0; b<_cellStart[nc+1]; b++) {
+	      int eb = _cellElems[b];
+	      _indexPairs.push_back(ea < eb ? std::make_pair(ea,eb) : std::make_pair(eb,ea));
+	    }
+	  }
+	}
+      }
+
+      return _indexPairs;
+    }
+
     ElemList getBoxNeighbors(int i) {
       VectorNI coords;
       getGridCoords(i,coords);
@@ -504,6 +604,12 @@ namespace voom
     bool _computeNeighbors;
     ElemPairContainer _elemPairs;
 
+    // flat cell list: elements of cell c are _cellElems[_cellStart[c].._cellStart[c+1]) //
+    IndexList _cellStart;
+    IndexList _cellElems;
+    IndexList _elemCells;
+    IndexPairList _indexPairs;
+
     PosFunc getElemPos;
 
   };
@@ -78,6 +78,8 @@ namespace voom
 
     double shear() const {return _shear;}
 
+    int shearDirection() const {return _shearDirection;}
+
     void setShear(double shear) {
       setShearX(shear);
     }
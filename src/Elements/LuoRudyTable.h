@@ -0,0 +1,189 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                    HoHai Van and William S. Klug
+//                University of California Los Angeles
+//                    (C) 2006 All Rights Reserved
+//
+//----------------------------------------------------------------------
+//
+// Reference:
+//  C. H. Luo and Y. Rudy, "A model of the ventricular cardiac action
+//  potential", Circ. Res. 68 (1991) 1501-1526.
+//  S. Rush and H. Larsen, "A practical algorithm for solving dynamic
+//  membrane equations", IEEE Trans. Biomed. Eng. 25 (1978) 389-392.
+//
+//----------------------------------------------------------------------
+
+/*!
+  \file LuoRudyTable.h
+
+  \brief Voltage indexed lookup table of Luo-Rudy gate rates and
+  voltage dependent currents, used by CardiacPotential::compute_ion.
+
+*/
+
+#if !defined(__LuoRudyTable_h__)
+#define __LuoRudyTable_h__
+
+#include <vector>
+#include <map>
+#include <cmath>
+
+namespace voom
+{
+
+  /*!  Every gate g of the Luo-Rudy model obeys dg/dt = (g_inf -
+    g)/tau_g with g_inf and tau_g functions of the membrane voltage
+    alone, so the Rush-Larsen update
+    \f[
+    g^{n+1} = g_\infty - (g_\infty - g^n) e^{-\Delta t/\tau_g}
+    \f]
+    is exact for frozen voltage and stable for any \f$\Delta t\f$.
+    The table stores g_inf and exp(-dt/tau_g) for all six gates, and
+    the purely voltage dependent parts of the potassium and background
+    currents, at equally spaced voltages, so that a gate update costs
+    two table reads and a linear interpolation instead of several
+    exp() calls.  Rows are contiguous, so one interpolation touches
+    two adjacent cache lines.  The table depends on dt; shared()
+    keeps one per time step.
+  */
+  class LuoRudyTable
+  {
+  public:
+
+    //! Columns of a row
+    enum Column { M_INF, M_EXP, H_INF, H_EXP, J_INF, J_EXP,
+		  D_INF, D_EXP, F_INF, F_EXP, X_INF, X_EXP,
+		  //! gk_bar*xi(V)*(V-E_k), multiplies the x gate
+		  G_K,
+		  //! i_k1 + i_kp + i_b
+		  I_BKG,
+		  NCOL };
+
+    LuoRudyTable(double vmin=-120.0, double vmax=80.0, double dv=0.1)
+      : _vmin(vmin), _dv(dv), _rows(int((vmax-vmin)/dv + 0.5) + 1), _dt(-1.0) {}
+
+    //! Time step the table was built for (negative if not built)
+    double timeStep() const { return _dt; }
+
+    //! Tabulate for time step dt
+    void build(double dt) {
+      _table.resize(_rows*NCOL);
+      for(int i=0; i<_rows; i++) {
+	const double V = _vmin + i*_dv;
+	double alpha[6], beta[6];
+	rates(V, alpha, beta);
+	double * row = &_table[i*NCOL];
+	for(int g=0; g<6; g++) {
+	  const double tau = 1.0/(alpha[g] + beta[g]);
+	  row[2*g]   = alpha[g]*tau;
+	  row[2*g+1] = std::exp(-dt/tau);
+	}
+	row[G_K] = potassium(V);
+	row[I_BKG] = background(V);
+      }
+      _dt = dt;
+    }
+
+    //! Row index i and interpolation weight s of voltage V (clamped)
+    void locate(double V, int & i, double & s) const {
+      double t = (V - _vmin)/_dv;
+      if( t < 0.0 ) t = 0.0;
+      if( t > _rows - 1.000001 ) t = _rows - 1.000001;
+      i = int(t);
+      s = t - i;
+    }
+
+    const double * row(int i) const { return &_table[i*NCOL]; }
+
+    //! Gate opening and closing rates at voltage V, in the order m,h,j,d,f,x
+    static void rates(double V, double * alpha, double * beta) {
+      const double vm = V + 47.13;
+      alpha[0] = ( std::abs(vm) < 1.0e-7 ? 3.2 : 0.32*vm/(1.0-std::exp(-0.1*vm)) );
+      beta[0] = 0.08*std::exp(-V/11.0);
+
+      if (V >= -40.0) {
+	alpha[1] = 0.0;
+	beta[1] = 1.0/(0.13*(1.0+std::exp((V+10.66)/-11.1)));
+	alpha[2] = 0.0;
+	beta[2] = 0.3*std::exp(-0.0000002535*V)/(1.0+std::exp(-0.1*(V+32.0)));
+      }
+      else {
+	alpha[1] = 0.135*std::exp((80.0+V)/-6.8);
+	beta[1] = 3.56*std::exp(0.079*V)+310000.0*std::exp(0.35*V);
+	alpha[2] = (-127140.0*std::exp(0.2444*V)-0.00003474*std::exp(-0.04391*V))*(V+37.78)/(1+std::exp(0.311*(V+79.23)));
+	beta[2] = 0.1212*std::exp(-0.01052*V)/(1.0+std::exp(-0.1378*(V+40.14)));
+      }
+
+      alpha[3] = (0.095*std::exp(-0.01*(V-5.0)))/(std::exp(-0.072*(V-5.0))+1.0);
+      beta[3] = (0.07*std::exp(-0.017*(V+44.0)))/(std::exp(0.05*(V+44.0))+1.0);
+
+      alpha[4] = (0.012*std::exp(-0.008*(V+28.0)))/(std::exp(0.15*(V+28.0))+1.0);
+      beta[4] = (0.0065*std::exp(-0.02*(V+30.0)))/(std::exp(-0.2*(V+30.0))+1.0);
+
+      alpha[5] = 0.0005*std::exp(0.083*(V+50.0))/(1.0+std::exp(0.057*(V+50.0)));
+      beta[5] = 0.0013*std::exp(-0.06*(V+20.0))/(1.0+std::exp(-0.04*(V+20.0)));
+    }
+
+    //! gk_bar*xi*(V+77), written without the removable singularity at V = -77
+    static double potassium(double V) {
+      const double gk_bar = 0.705;
+      if (V <= -100.0) return gk_bar*(V+77.0);
+      return gk_bar*2.837*(std::exp(0.04*(V+77.0))-1.0)/std::exp(0.04*(V+35.0));
+    }
+
+    //! Time independent potassium, plateau potassium and background currents
+    static double background(double V) {
+      const double gk1_bar = 0.6047;
+      const double a_k1 = 1.02/(1.0+std::exp(0.2385*(V+87.95-59.215)));
+      double b_k1 = 0.49124*std::exp(0.08032*(V+87.95+5.476))+std::exp(0.06175*(V+87.95-594.31));
+      b_k1 /= 1.0+std::exp(-0.5143*(V+87.95+4.753));
+      const double i_k1 = gk1_bar*a_k1/(a_k1+b_k1)*(V+87.95);
+
+      const double kp = 1.0/(1.0+std::exp((7.488-V)/5.98));
+      const double i_kp = 0.0183*kp*(V+87.95);
+
+      const double i_b = 0.03921*(V+59.87);
+      return i_k1 + i_kp + i_b;
+    }
+
+    //! Process wide table for time step dt, built on first use
+    /*! One table is kept per time step and never rebuilt or freed,
+      so a reference stays valid while other threads ask for other
+      time steps.  Tables are found and built inside a critical
+      section; each thread remembers the last one it obtained there,
+      so the common case (same dt as the previous call) takes no
+      lock and reads no shared state. */
+    static const LuoRudyTable & shared(double dt) {
+      static const LuoRudyTable * last = 0;
+#ifdef _OPENMP
+#pragma omp threadprivate(last)
+#endif
+      if( last == 0 || last->timeStep() != dt ) {
+#ifdef _OPENMP
+#pragma omp critical(LuoRudyTableBuild)
+#endif
+	{
+	  static std::map<double, LuoRudyTable*> tables;
+	  LuoRudyTable *& table = tables[dt];
+	  if( table == 0 ) {
+	    table = new LuoRudyTable;
+	    table->build(dt);
+	  }
+	  last = table;
+	}
+      }
+      return *last;
+    }
+
+  private:
+    double _vmin, _dv;
+    int _rows;
+    double _dt;
+    std::vector<double> _table;
+  };
+
+}; // namespace voom
+
+#endif // __LuoRudyTable_h__
@@ -33,38 +33,23 @@ namespace voom
 
     PinchForce(Node_t * node1, Node_t * node2, double f0, PeriodicBox * box) 
       : _node1(node1), _node2(node2), _f0(f0), _box(box) { 
+      _baseNodes.push_back(_node1);
+      _baseNodes.push_back(_node2);
     }
 
     void setBox(PeriodicBox * pb) {
       _box = pb;
     }
 
-    void compute(bool f0, bool f1, bool f2) {
+    void compute(bool f0, bool f1, bool f2) { _compute(f0,f1,f2,false); }
+
+    //! compute() for callers that make sure no other thread writes to
+    //! the two nodes meanwhile; forces are added without atomics
+    void computeExclusive(bool f0, bool f1, bool f2) { _compute(f0,f1,f2,true); }
+
+    //! The nodes are fixed at construction
+    unsigned int generation() const { return 0; }
 
-      const VectorND & x1 = _node1->point();
-      const VectorND & x2 = _node2->point();
-      //Periodic BC
- 
-      VectorND dx(0.0);
-      dx = x2 - x1;
-      _box->mapDistance(dx);
-      double d = norm2(dx);
-      
-      if(f0) {
-	_energy = _f0*d;
-      }
-      
-      if(f1) {
-	for(int i=0; i<N; i++) {
-	  double f = (dx(i)/d)*_f0;
-	  _node1->addForce(i, -f);
-	  _node2->addForce(i, f);
-	}
-	
-      }
-      return;
-    }
-    
     double pinchF() const {return _f0;}
 
     void setPinchF(double f0) { _f0 = f0; }
@@ -86,6 +71,37 @@ namespace voom
 //       }
 //     }
   private:
+
+    void _compute(bool f0, bool f1, bool f2, bool exclusive) {
+
+      const VectorND & x1 = _node1->point();
+      const VectorND & x2 = _node2->point();
+      //Periodic BC
+ 
+      VectorND dx(0.0);
+      dx = x2 - x1;
+      _box->mapDistance(dx);
+      double d = norm2(dx);
+      
+      if(f0) {
+	_energy = _f0*d;
+      }
+      
+      if(f1) {
+	for(int i=0; i<N; i++) {
+	  double f = (dx(i)/d)*_f0;
+	  if(exclusive) {
+	    _node1->addForceExclusive(i, -f);
+	    _node2->addForceExclusive(i, f);
+	  } else {
+	    _node1->addForce(i, -f);
+	    _node2->addForce(i, f);
+	  }
+	}
+	
+      }
+      return;
+    }
     
     Node_t * _node1;
     Node_t * _node2;
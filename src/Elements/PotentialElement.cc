@@ -18,14 +18,43 @@ namespace voom {
     if (fl0) {
     _energy = 0.0;
     }
-	    
+
+    // gather separations and evaluate all pairs in one kernel call;
+    // the potential is not modified, so elements may run concurrently
+    const int n = _domain.size();
+    if (n == 0) return;
+    _dx.resize(n);
+    _r.resize(n);
+    _W.resize(n);
+    _F.resize(n);
+    int k = 0;
     for (set<DeformationNode<3> *>::iterator pNode = _domain.begin();
-	pNode != _domain.end(); pNode++)
+	pNode != _domain.end(); pNode++, k++)
     {
-	_mat->updateState(_center, *pNode, fl0, fl1, fl2);
-	if (fl0) {
-	  _energy += _mat->energy();
-	}
+      _dx[k] = _center->point() - (*pNode)->point();
+      _r[k] = tvmet::norm2(_dx[k]);
+    }
+    _mat->pairKernel(n, &_r[0], (fl0 ? &_W[0] : 0), (fl1 ? &_F[0] : 0));
+
+    k = 0;
+    for (set<DeformationNode<3> *>::iterator pNode = _domain.begin();
+	pNode != _domain.end(); pNode++, k++)
+    {
+      if (fl0) {
+	_energy += _W[k];
+      }
+      if (fl1) {
+	Vector3D ForceIncrement(0.0);
+	ForceIncrement = _F[k]*_dx[k];
+	_center->updateForce(ForceIncrement);
+	ForceIncrement = -ForceIncrement;
+	(*pNode)->updateForce(ForceIncrement);
+      }
+    }
+
+    if (fl2) {
+      // Not implemented 
+      cout << "Stiffness calculations in PotentialElement not implemented " << endl;
     }
 
   }
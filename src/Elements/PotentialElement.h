@@ -50,7 +50,11 @@ namespace voom {
     //! Based on nodal postitions, calculates energy and nodal forces
     void compute(bool f0, bool f1, bool f2);
    
-    void resetDomain(set<DeformationNode<3> * > NewDomain) { _domain = NewDomain; };
+    void resetDomain(set<DeformationNode<3> * > NewDomain) {
+      _domain = NewDomain;
+      _baseNodes.assign(_domain.begin(), _domain.end());
+      _baseNodes.push_back(_center);
+    };
 
     void getTensions(vector<Vector3D > & OneElementsMidPoints, vector<double > & OneElementTension);
     
@@ -63,6 +67,10 @@ namespace voom {
     DeformationNode<3> * _center;
     set<DeformationNode<3> * > _domain;
 
+    // Scratch arrays for the batched pair kernel
+    vector<Vector3D > _dx;
+    vector<double > _r, _W, _F;
+
   }; // Potential element class
   
 }
@@ -0,0 +1,139 @@
+#include <vector>
+#include <iostream>
+#include <cmath>
+
+#include "CardiacPotential.icc"
+#include "CardiacSplitStepper.h"
+#include "HexQuadrature.h"
+#include "ShapeHex8.h"
+
+using namespace std;
+using namespace voom;
+
+typedef CardiacPotential<HexQuadrature,ShapeHex8,3> Element_t;
+typedef Element_t::Node_t Node_t;
+
+const int nElements = 40;
+const double h = 0.01;          // element length (cm)
+const double dt = 0.01;         // time step (ms)
+const double tEnd = 20.0;
+const double tStim = 1.0;
+const double iStim = 80.0;
+const int nStim = 2;            // stimulated elements at x = 0
+const double vRest = -84.0;
+const double vActive = -20.0;
+
+// Cable of hex elements along x, four nodes per cross section
+struct Cable {
+  vector<Node_t*> nodes;
+  vector<Element_t*> elements;
+
+  Cable() {
+    HexQuadrature quad(1);
+    for(int i=0; i<=nElements; i++) {
+      for(int k=0; k<4; k++) {
+	Node_t::PositionVector X;
+	X = i*h, (k/2)*h, (k%2)*h;
+	nodes.push_back(new Node_t(nodes.size(), NodeBase::DofIndexMap(1), X, vRest));
+	nodes.back()->setForce(0, 0.0);
+      }
+    }
+    // node n(i,y,z) of plane i is nodes[4*i+2*y+z]
+    for(int e=0; e<nElements; e++) {
+      Element_t::VoltageNodeContainer en(8);
+      en[0] = nodes[4*e+1];     en[1] = nodes[4*(e+1)+1];
+      en[2] = nodes[4*(e+1)];   en[3] = nodes[4*e];
+      en[4] = nodes[4*e+3];     en[5] = nodes[4*(e+1)+3];
+      en[6] = nodes[4*(e+1)+2]; en[7] = nodes[4*e+2];
+      double fiber[3] = {0.0, 0.0, 0.0};
+      elements.push_back(new Element_t(quad, en, 0.001, fiber));
+    }
+  }
+
+  ~Cable() {
+    for(int e=0; e<elements.size(); e++) delete elements[e];
+    for(int i=0; i<nodes.size(); i++) delete nodes[i];
+  }
+
+  //! record the first time each plane is depolarized
+  void activation(double t, vector<double> & times) const {
+    for(int i=0; i<=nElements; i++)
+      if( times[i] < 0.0 && nodes[4*i]->getPoint(0) > vActive ) times[i] = t;
+  }
+};
+
+// Activation times of the planes with the explicit full step of
+// compute_ion (reaction and diffusion from the same voltages)
+void fullStep(vector<double> & times) {
+  Cable cable;
+  times.assign(nElements+1, -1.0);
+  const int steps = int(tEnd/dt + 0.5);
+  for(int n=0; n<steps; n++) {
+    const double t = n*dt;
+    for(int e=0; e<nElements; e++)
+      cable.elements[e]->compute_ion(dt, (e<nStim && t<tStim ? iStim : 0.0), true);
+    for(int i=0; i<cable.nodes.size(); i++) {
+      Node_t * nd = cable.nodes[i];
+      nd->addPoint(0, dt*nd->getForce(0)/nd->getCapacitance(0));
+      nd->setForce(0, 0.0);
+    }
+    cable.activation(t+dt, times);
+  }
+}
+
+// Activation times with CardiacSplitStepper; returns the number of
+// element reaction updates
+long splitStep(vector<double> & times, int maxSubsteps, int stride) {
+  Cable cable;
+  times.assign(nElements+1, -1.0);
+  CardiacSplitStepper<Element_t> stepper(cable.elements, cable.nodes, dt,
+					 maxSubsteps, stride);
+  const int steps = int(tEnd/dt + 0.5);
+  for(int n=0; n<steps; n++) {
+    for(int e=0; e<nStim; e++) stepper.setStimulus(e, (n*dt<tStim ? iStim : 0.0));
+    stepper.step();
+    cable.activation(stepper.time(), times);
+  }
+  return stepper.reactionUpdates();
+}
+
+double maxDifference(const vector<double> & a, const vector<double> & b) {
+  double d = 0.0;
+  for(int i=0; i<a.size(); i++) {
+    if( a[i] < 0.0 || b[i] < 0.0 ) return -1.0;
+    d = max(d, abs(a[i]-b[i]));
+  }
+  return d;
+}
+
+int main()
+{
+  vector<double> full, lie, multirate;
+  fullStep(full);
+  splitStep(lie, 1, 1);
+  const long updates = splitStep(multirate, 8, 8);
+  const long allUpdates = long(nElements)*int(tEnd/dt + 0.5);
+
+  const double conduction = full[nElements] - full[0];
+  const double dLie = maxDifference(lie, full);
+  const double dMultirate = maxDifference(multirate, lie);
+  cout << "conduction time " << conduction << " ms" << endl
+       << "Lie split vs full step: max activation time difference " << dLie << " ms" << endl
+       << "multirate vs Lie split: max activation time difference " << dMultirate << " ms, "
+       << updates << " of " << allUpdates << " element updates" << endl;
+
+  bool passed = ( full[nElements] > 0.0 && conduction > 0.0 );
+  // the splitting error changes the conduction velocity by O(dt); the
+  // multirate scheme may further delay wake-up at the wavefront by
+  // less than a stride per element
+  passed = passed && dLie >= 0.0 && dLie <= 0.02*conduction;
+  passed = passed && dMultirate >= 0.0 && dMultirate <= 0.05*conduction;
+  passed = passed && updates < allUpdates/2;
+
+  if(passed) {
+    cout << "CardiacSplitStepper test PASSED!" << endl;
+    return 0;
+  }
+  cout << "CardiacSplitStepper test FAILED!" << endl;
+  return 1;
+}
@@ -0,0 +1,113 @@
+#include <vector>
+#include <set>
+#include <map>
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+
+#include "VoomMath.h"
+#include "LeesEdwards.h"
+#include "Grid.h"
+
+using namespace std;
+using namespace voom;
+
+// Point particle with the position accessor the grid expects
+struct Particle {
+  Vector2D x;
+  const Vector2D & position() { return x; }
+};
+
+typedef Grid<Particle,Particle,2> Grid_t;
+
+// Pairs (i<j) closer than rc in any periodic image of the sheared
+// cell, by brute force over images x_j - x_i + m a1 + n a2
+set< pair<int,int> > bruteForcePairs(const vector<Particle*> & ps,
+				     const LeesEdwards & box, double rc) {
+  const Vector2D & h = box.size();
+  Vector2D a1, a2;
+  if(box.shearDirection() == 0) {
+    a1 = h(0), 0.0;
+    a2 = box.shear()*h(1), h(1);
+  }
+  else {
+    a1 = h(0), -box.shear()*h(0);
+    a2 = 0.0, h(1);
+  }
+  set< pair<int,int> > pairs;
+  for(int i=0; i<ps.size(); i++) {
+    for(int j=i+1; j<ps.size(); j++) {
+      double dmin = 1.0e30;
+      for(int m=-4; m<=4; m++) {
+	for(int n=-4; n<=4; n++) {
+	  Vector2D d;
+	  d = ps[j]->x - ps[i]->x + double(m)*a1 + double(n)*a2;
+	  dmin = min(dmin, tvmet::norm2(d));
+	}
+      }
+      if(dmin < rc) pairs.insert(make_pair(i,j));
+    }
+  }
+  return pairs;
+}
+
+// Compare the Lees-Edwards cell-list pairs of getNeighborPairs() with
+// a brute-force search, for shear along x and y at several offsets
+// (including ones beyond a full period).  Every pair within the cell
+// size must be listed, and no pair may be listed twice.
+int main()
+{
+  const int nParticles = 150;
+  const double Lx = 10.0, Ly = 8.0;
+  const double shears[] = {0.1, 0.35, -0.4, 0.62, 1.3, -2.7};
+  const int nShears = sizeof(shears)/sizeof(double);
+
+  bool passed = true;
+  srand(1);
+  for(int sd=0; sd<2; sd++) {
+    for(int s=0; s<nShears; s++) {
+      LeesEdwards box(Lx, Ly, shears[s], sd);
+
+      // uniform in the unsheared cell, mapped into the sheared one
+      vector<Particle*> ps;
+      for(int p=0; p<nParticles; p++) {
+	Vector2D X;
+	X = Lx*rand()/RAND_MAX, Ly*rand()/RAND_MAX;
+	ps.push_back(new Particle);
+	box.mapping(X, ps.back()->x);
+      }
+
+      Vector2D spacing(1.0);
+      Grid_t grid(&box, spacing, &Particle::position);
+      const double rc = min(grid.gridSpace()(0), grid.gridSpace()(1));
+      const Grid_t::IndexPairList & list = grid.getNeighborPairs(ps);
+
+      set< pair<int,int> > found;
+      int duplicates = 0;
+      for(int k=0; k<list.size(); k++) {
+	if(list[k].first >= list[k].second) duplicates++;
+	if(!found.insert(list[k]).second) duplicates++;
+      }
+
+      set< pair<int,int> > exact = bruteForcePairs(ps, box, rc);
+      int missing = 0;
+      for(set< pair<int,int> >::iterator p=exact.begin(); p!=exact.end(); p++)
+	if(found.find(*p) == found.end()) missing++;
+
+      cout << "shear " << shears[s] << " along " << (sd == 0 ? "x" : "y")
+	   << ": " << exact.size() << " pairs within " << rc << ", "
+	   << list.size() << " listed, " << missing << " missing, "
+	   << duplicates << " duplicate" << endl;
+      passed = passed && missing == 0 && duplicates == 0;
+
+      for(int p=0; p<ps.size(); p++) delete ps[p];
+    }
+  }
+
+  if(passed) {
+    cout << "Grid::getNeighborPairs test PASSED!" << endl;
+    return 0;
+  }
+  cout << "Grid::getNeighborPairs test FAILED!" << endl;
+  return 1;
+}
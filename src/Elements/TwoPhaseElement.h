@@ -114,7 +114,7 @@ namespace voom
 	_quadPoints.clear();
 	for(typename Quadrature_t::ConstPointIterator p=quad.begin(); 
 	    p!=quad.end(); p++) {
-	  Shape_t shp( nNodes, V, p->coords );
+	  const Shape_t & shp = Shape_t::shared( nNodes, V, p->coords );
 	  _quadPoints.push_back( QuadPointStruct(p->weight, mat, shp) ); 
 	}
 
@@ -16,20 +16,15 @@ namespace voom {
   void LennardJones::updateState(DeformationNode<3> *nodeA, DeformationNode<3> *nodeB, bool fl0, bool fl1, bool fl2)
   {
     double r = tvmet::norm2( nodeA->point() - nodeB->point() );
-    if (fl0) {
-      	// Lennard Jones energy
-      	_W = 4.0*_epsilon*(pow(_sigma/r, 12.0) - pow(_sigma/r, 6.0)); 
-    }
-    
+    double factor = 0.0;
+    pairKernel(1, &r, (fl0 ? &_W : 0), (fl1 ? &factor : 0));
+
     if (fl1) {
-	// Lennard Jones forces
-	double factor = (4.0*_epsilon/pow(r, 2.0))*(6.0*pow(_sigma/r, 6.0) - 12.0*pow(_sigma/r, 12.0));
-	
-        Vector3D ForceIncrement(0.0);
-	ForceIncrement = factor*(nodeA->point() - nodeB->point());
-	nodeA->updateForce(ForceIncrement);
-	ForceIncrement = -ForceIncrement;
-	nodeB->updateForce(ForceIncrement);
+      Vector3D ForceIncrement(0.0);
+      ForceIncrement = factor*(nodeA->point() - nodeB->point());
+      nodeA->updateForce(ForceIncrement);
+      ForceIncrement = -ForceIncrement;
+      nodeB->updateForce(ForceIncrement);
     }
 
     if (fl2) {
@@ -44,9 +39,29 @@ namespace voom {
   double LennardJones::computeTension(DeformationNode<3> *nodeA, DeformationNode<3> *nodeB)
   {
     double r = tvmet::norm2( nodeA->point() - nodeB->point() );
-    return (4.0*_epsilon/r)*(6.0*pow(_sigma/r, 6.0) - 12.0*pow(_sigma/r, 12.0));
+    double factor = 0.0;
+    pairKernel(1, &r, 0, &factor);
+    return factor*r;
   } // LennardJones::computeTension
 
 
 
+  void LennardJones::pairKernel(int n, const double * r, double * W, double * F) const
+  {
+    const double e4 = 4.0*_epsilon, s2 = _sigma*_sigma;
+#if defined(_OPENMP) && (_OPENMP >= 201307)
+#pragma omp simd
+#endif
+    for (int k = 0; k < n; k++) {
+      const double ir2 = 1.0/(r[k]*r[k]);
+      const double x2 = s2*ir2;
+      const double x6 = x2*x2*x2;
+      const double x12 = x6*x6;
+      if (W) W[k] = e4*(x12 - x6);
+      if (F) F[k] = e4*ir2*(6.0*x6 - 12.0*x12);
+    }
+  } // LennardJones::pairKernel
+
+
+
 } // namespace voom
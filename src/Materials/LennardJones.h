@@ -45,6 +45,9 @@ namespace voom {
     void updateState(DeformationNode<3> *nodeA, DeformationNode<3> *nodeB, bool f0, bool f1, bool f2);
 
     double computeTension(DeformationNode<3> *nodeA, DeformationNode<3> *nodeB);
+
+    //! Energies and force factors W'(r)/r for n separations
+    void pairKernel(int n, const double * r, double * W, double * F) const;
   
     void setScaling(double epsilon) { _epsilon = epsilon; }; 
     void setEpsilon(double epsilon) { _epsilon = epsilon; };
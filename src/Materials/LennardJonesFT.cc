@@ -16,20 +16,15 @@ namespace voom {
   void LennardJonesFT::updateState(DeformationNode<3> *nodeA, DeformationNode<3> *nodeB, bool fl0, bool fl1, bool fl2)
   {
     double r = tvmet::norm2( nodeA->point() - nodeB->point() );
-    if (fl0) {
-      // Lennard JonesFT energy
-      _W = _epsilon*(pow(_sigma/(r-_Rshift), 4.0) - pow(_sigma/(r-_Rshift), 2.0)); 
-    }
-    
+    double factor = 0.0;
+    pairKernel(1, &r, (fl0 ? &_W : 0), (fl1 ? &factor : 0));
+
     if (fl1) {
-	// Lennard JonesFT forces
-      double factor = (_epsilon/(r-_Rshift))*(2.0*pow(_sigma/(r-_Rshift), 2.0) - 4.0*pow(_sigma/(r-_Rshift), 4.0))/r;
-	
-        Vector3D ForceIncrement(0.0);
-	ForceIncrement = factor*(nodeA->point() - nodeB->point());
-	nodeA->updateForce(ForceIncrement);
-	ForceIncrement = -ForceIncrement;
-	nodeB->updateForce(ForceIncrement);
+      Vector3D ForceIncrement(0.0);
+      ForceIncrement = factor*(nodeA->point() - nodeB->point());
+      nodeA->updateForce(ForceIncrement);
+      ForceIncrement = -ForceIncrement;
+      nodeB->updateForce(ForceIncrement);
     }
 
     if (fl2) {
@@ -44,8 +39,26 @@ namespace voom {
   double LennardJonesFT::computeTension(DeformationNode<3> *nodeA, DeformationNode<3> *nodeB)
   {
     double r = tvmet::norm2( nodeA->point() - nodeB->point() );
-    return (_epsilon/(r-_Rshift))*(2.0*pow(_sigma/(r-_Rshift), 2.0) - 4.0*pow(_sigma/(r-_Rshift), 4.0));
+    double factor = 0.0;
+    pairKernel(1, &r, 0, &factor);
+    return factor*r;
   } // LennardJones::computeTension
 
 
+
+  void LennardJonesFT::pairKernel(int n, const double * r, double * W, double * F) const
+  {
+#if defined(_OPENMP) && (_OPENMP >= 201307)
+#pragma omp simd
+#endif
+    for (int k = 0; k < n; k++) {
+      const double id = 1.0/(r[k] - _Rshift);
+      const double x2 = _sigma*_sigma*id*id;
+      const double x4 = x2*x2;
+      if (W) W[k] = _epsilon*(x4 - x2);
+      if (F) F[k] = _epsilon*id*(2.0*x2 - 4.0*x4)/r[k];
+    }
+  } // LennardJonesFT::pairKernel
+
+
 } // namespace voom
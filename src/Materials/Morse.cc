@@ -16,19 +16,10 @@ namespace voom {
   void Morse::updateState(DeformationNode<3> *nodeA, DeformationNode<3> *nodeB, bool fl0, bool fl1, bool fl2)
   {
     double r = tvmet::norm2( nodeA->point() - nodeB->point() );
-    if (fl0) {
-      // Morse energy
-      // _W = _epsilon*pow(1.0 - exp(-_sigma*(r - _Rshift)),2.0);
-      _W = _epsilon*(exp(-2*_sigma*(r-_Rshift))-2*exp(-_sigma*(r-_Rshift)));
-    }
-    
-    if (fl1) {
-      // Morse forces
-      //double factor = 2.0*_epsilon*_sigma*(1.0 - exp(-_sigma*(r - _Rshift)))*
-      //exp(-_sigma*(r - _Rshift))/r;
+    double factor = 0.0;
+    pairKernel(1, &r, (fl0 ? &_W : 0), (fl1 ? &factor : 0));
 
-      double factor = ((2.0*_sigma*exp(-(r-_Rshift)*_sigma)-2.0*_sigma*exp(-2.0*(r-_Rshift)*_sigma))
-		       *_epsilon)/r;	
+    if (fl1) {
       Vector3D ForceIncrement(0.0);
       ForceIncrement = factor*(nodeA->point() - nodeB->point());
       nodeA->updateForce(ForceIncrement);
@@ -49,10 +40,24 @@ namespace voom {
   double Morse::computeTension(DeformationNode<3> *nodeA, DeformationNode<3> *nodeB)
   {
     double r = tvmet::norm2( nodeA->point() - nodeB->point() );
-    //return 2.0*_epsilon*_sigma*(1.0 - exp(-_sigma*(r - _Rshift)))*exp(-_sigma*(r - _Rshift));
-    return (2.0*_sigma*exp(-(r-_Rshift)*_sigma)-2.0*_sigma*exp(-2.0*(r-_Rshift)*_sigma))
-	    *_epsilon;
+    double factor = 0.0;
+    pairKernel(1, &r, 0, &factor);
+    return factor*r;
   } // Morse::computeTension
 
 
+
+  void Morse::pairKernel(int n, const double * r, double * W, double * F) const
+  {
+#if defined(_OPENMP) && (_OPENMP >= 201307)
+#pragma omp simd
+#endif
+    for (int k = 0; k < n; k++) {
+      const double e1 = exp(-_sigma*(r[k] - _Rshift));
+      if (W) W[k] = _epsilon*(e1*e1 - 2.0*e1);
+      if (F) F[k] = 2.0*_epsilon*_sigma*e1*(1.0 - e1)/r[k];
+    }
+  } // Morse::pairKernel
+
+
 } // namespace voom
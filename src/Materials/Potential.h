@@ -38,6 +38,16 @@ class Potential
 
   virtual double computeTension(DeformationNode<3> *nodeA, DeformationNode<3> *nodeB) = 0;
 
+  //! Batched, stateless pair kernel
+  /*! For n separations r[k] > 0 computes the pair energy W[k] = W(r[k])
+    and the scalar force factor F[k] = W'(r[k])/r[k], so that the force
+    on node A of a pair is F[k]*(xA - xB) and on node B its negative.
+    Either output may be null.  The kernel reads only the potential
+    parameters, so one potential can be shared by many threads, and
+    the loops are written to vectorize.
+  */
+  virtual void pairKernel(int n, const double * r, double * W, double * F) const = 0;
+
  protected:
   double _W; // Energy
 
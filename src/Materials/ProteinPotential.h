@@ -49,6 +49,9 @@ namespace voom {
       return tvmet::norm2(a - b);
     }
 
+    //! Period of the periodic BC along Z (negative if not periodic)
+    double getLength() const { return _length; };
+
     DeformationNode<3> * getHost() { return _host; };
     void setHost(DeformationNode<3> * NewHost) { _host = NewHost; };
     
@@ -16,20 +16,15 @@ namespace voom {
   void SpringPotentialSQ::updateState(DeformationNode<3> *nodeA, DeformationNode<3> *nodeB, bool fl0, bool fl1, bool fl2)
   {
     double r = tvmet::norm2( nodeA->point() - nodeB->point() );
-    if (fl0) {
-      	// Spring energy
-	_W = 0.5*_springK*pow(r - _restL, 4.0);
-    }
-    
+    double factor = 0.0;
+    pairKernel(1, &r, (fl0 ? &_W : 0), (fl1 ? &factor : 0));
+
     if (fl1) {
-	// Spring force
-	double factor = 2.0*_springK*pow(r - _restL, 3.0)/r;
-
-	Vector3D ForceIncrement(0.0);
-	ForceIncrement = factor*(nodeA->point() - nodeB->point());
-	nodeA->updateForce(ForceIncrement);
-	ForceIncrement = -ForceIncrement;
-	nodeB->updateForce(ForceIncrement);
+      Vector3D ForceIncrement(0.0);
+      ForceIncrement = factor*(nodeA->point() - nodeB->point());
+      nodeA->updateForce(ForceIncrement);
+      ForceIncrement = -ForceIncrement;
+      nodeB->updateForce(ForceIncrement);
     }
 
     if (fl2) {
@@ -42,7 +37,24 @@ namespace voom {
 
   double SpringPotentialSQ::computeTension(DeformationNode<3> *nodeA, DeformationNode<3> *nodeB) {
     double r = tvmet::norm2( nodeA->point() - nodeB->point() );
-    return 2.0*_springK*pow(r - _restL, 3.0);
+    double factor = 0.0;
+    pairKernel(1, &r, 0, &factor);
+    return factor*r;
   }
 
+
+
+  void SpringPotentialSQ::pairKernel(int n, const double * r, double * W, double * F) const
+  {
+#if defined(_OPENMP) && (_OPENMP >= 201307)
+#pragma omp simd
+#endif
+    for (int k = 0; k < n; k++) {
+      const double d = r[k] - _restL;
+      const double d2 = d*d;
+      if (W) W[k] = 0.5*_springK*d2*d2;
+      if (F) F[k] = 2.0*_springK*d2*d/r[k];
+    }
+  } // SpringPotentialSQ::pairKernel
+
 } // namespace voom
@@ -46,6 +46,9 @@ namespace voom {
 
     double computeTension(DeformationNode<3> *nodeA, DeformationNode<3> *nodeB);
 
+    //! Energies and force factors W'(r)/r for n separations
+    void pairKernel(int n, const double * r, double * W, double * F) const;
+
     void setScaling(double springK) { _springK = springK; };   
     void setSpringK(double springK) { _springK = springK; };
     void setRestL(double restL) { _restL = restL; };
@@ -0,0 +1,116 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+
+#include <algorithm>
+#include "LoopSubdivision.h"
+
+namespace voom
+{
+
+  LoopSubdivision::LoopSubdivision(const ConnectivityContainer & connectivities,
+				   int nVertices)
+  {
+    HalfEdgeMesh mesh(connectivities, nVertices);
+    const int nh = mesh.halfEdges.size();
+
+    // one new vertex per edge, shared by the two half-edges
+    std::vector<int> edgeVertex(nh, -1);
+    std::vector<HalfEdge*> edges;
+    for(int h=0; h<nh; h++) {
+      HalfEdge * H = mesh.halfEdges[h];
+      if( edgeVertex[h] >= 0 ) continue;
+      edgeVertex[h] = nVertices + edges.size();
+      if( H->opposite ) edgeVertex[H->opposite->id] = edgeVertex[h];
+      edges.push_back(H);
+    }
+
+    // vertex rule
+    std::vector<int> cols, ring, ends;
+    std::vector<double> weights;
+    for(int v=0; v<nVertices; v++) {
+      Vertex * V = mesh.vertices[v];
+      ring.clear();
+      ends.clear();
+      for(int k=0; k<V->halfEdges.size(); k++) {
+	HalfEdge * H = V->halfEdges[k];
+	ring.push_back(H->prev->vertex->id);
+	ring.push_back(H->next->vertex->id);
+	// neighbors across boundary edges
+	if( !H->opposite ) ends.push_back(H->prev->vertex->id);
+	if( !H->next->opposite ) ends.push_back(H->next->vertex->id);
+      }
+      std::sort(ring.begin(), ring.end());
+      ring.erase(std::unique(ring.begin(), ring.end()), ring.end());
+
+      cols.assign(1, v);
+      weights.clear();
+      if( ends.size() == 2 ) {
+	weights.push_back(0.75);
+	for(int k=0; k<2; k++) {
+	  cols.push_back(ends[k]);
+	  weights.push_back(0.125);
+	}
+      } else if( ends.size() > 0 || ring.empty() ) {
+	// corner or non-manifold boundary vertex: keep it
+	weights.push_back(1.0);
+      } else {
+	const int n = ring.size();
+	const double w = 0.375/n;
+	weights.push_back(1.0 - n*w);
+	for(int k=0; k<n; k++) {
+	  cols.push_back(ring[k]);
+	  weights.push_back(w);
+	}
+      }
+      _prolongation.addRow(cols, weights);
+    }
+
+    // edge rule
+    for(int e=0; e<edges.size(); e++) {
+      HalfEdge * H = edges[e];
+      cols.clear();
+      weights.clear();
+      cols.push_back(H->prev->vertex->id);
+      cols.push_back(H->vertex->id);
+      if( H->opposite ) {
+	cols.push_back(H->next->vertex->id);
+	cols.push_back(H->opposite->next->vertex->id);
+	weights.push_back(0.375);
+	weights.push_back(0.375);
+	weights.push_back(0.125);
+	weights.push_back(0.125);
+      } else {
+	weights.push_back(0.5);
+	weights.push_back(0.5);
+      }
+      _prolongation.addRow(cols, weights);
+    }
+
+    // each triangle into four; half-edge i of a face ends at its vertex i
+    _connectivities.resize( 4*connectivities.size() );
+    for(int f=0; f<connectivities.size(); f++) {
+      const int v0 = connectivities[f](0);
+      const int v1 = connectivities[f](1);
+      const int v2 = connectivities[f](2);
+      const int m20 = edgeVertex[3*f];
+      const int m01 = edgeVertex[3*f+1];
+      const int m12 = edgeVertex[3*f+2];
+      TriangleConnectivity c;
+      c = v0, m01, m20;
+      _connectivities[4*f] = c;
+      c = v1, m12, m01;
+      _connectivities[4*f+1] = c;
+      c = v2, m20, m12;
+      _connectivities[4*f+2] = c;
+      c = m01, m12, m20;
+      _connectivities[4*f+3] = c;
+    }
+  }
+
+}; // namespace voom
@@ -0,0 +1,106 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+//
+// Reference:
+//  C. Loop, "Smooth subdivision surfaces based on triangles", M.S.
+//  thesis, University of Utah (1987).
+//  F. Cirak, M. Ortiz and P. Schroder, "Subdivision surfaces: a new
+//  paradigm for thin-shell finite-element analysis", Int. J. Numer.
+//  Meth. Engng. 47 (2000) 2039-2072.
+//
+/////////////////////////////////////////////////////////////////////////
+
+/*!
+  \file LoopSubdivision.h
+
+  \brief One level of Loop subdivision of a triangle mesh, with the
+  prolongation from the coarse to the refined control points.
+
+*/
+
+#if !defined(__LoopSubdivision_h__)
+#define __LoopSubdivision_h__
+
+#include <vector>
+#include "HalfEdgeMesh.h"
+#include "Multigrid.h"
+
+namespace voom
+{
+
+  /*!  Splits every triangle of a mesh into four and computes the
+    Loop subdivision rules that give the refined control points from
+    the coarse ones.  The coarse vertices keep their numbers
+    0..nVertices-1 and one new vertex per edge is appended.  The
+    vertex rule uses the same (Warren) weights as LoopShellShape, so
+    a Loop shell on the refined mesh with prolongated control points
+    is the same surface as on the coarse mesh: the finite element
+    spaces are nested and the prolongation is exactly what a Galerkin
+    multigrid hierarchy needs.  Boundary edges and vertices use the
+    cubic B-spline curve rules.
+
+    A hierarchy for Multigrid, from an icosahedron say:
+    \code
+    std::vector<Prolongation> P;
+    ConnectivityContainer conn = icosahedron;
+    int nv = 12;
+    for(int l=0; l<levels; l++) {
+      LoopSubdivision refine(conn, nv);
+      P.push_back( refine.prolongation().expand(3) );
+      conn = refine.connectivities();
+      nv = refine.vertices();
+    }
+    \endcode
+  */
+  class LoopSubdivision
+  {
+  public:
+
+    typedef HalfEdgeMesh::TriangleConnectivity TriangleConnectivity;
+    typedef HalfEdgeMesh::ConnectivityContainer ConnectivityContainer;
+
+    LoopSubdivision(const ConnectivityContainer & connectivities, int nVertices);
+
+    //! Refined mesh
+    const ConnectivityContainer & connectivities() const { return _connectivities; }
+
+    //! Number of refined vertices
+    int vertices() const { return _prolongation.rows(); }
+
+    //! Refined vertex values from coarse ones, one value per vertex
+    const Prolongation & prolongation() const { return _prolongation; }
+
+    //! Refined points from coarse points (any fixed size vector type)
+    template<class Point_t>
+    void refine(const std::vector<Point_t> & coarse, std::vector<Point_t> & fine) const;
+
+  private:
+
+    ConnectivityContainer _connectivities;
+    Prolongation _prolongation;
+  };
+
+
+
+  template<class Point_t>
+  void LoopSubdivision::refine(const std::vector<Point_t> & coarse,
+			       std::vector<Point_t> & fine) const {
+    const std::vector<int> & ptr = _prolongation.rowPointers();
+    const std::vector<int> & col = _prolongation.columns();
+    const std::vector<double> & val = _prolongation.values();
+    fine.resize( vertices() );
+    for(int i=0; i<fine.size(); i++) {
+      fine[i] = 0.0;
+      for(int k=ptr[i]; k<ptr[i+1]; k++) fine[i] += val[k]*coarse[col[k]];
+    }
+  }
+
+}; // namespace voom
+
+#endif // __LoopSubdivision_h__
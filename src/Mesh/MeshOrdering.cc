@@ -0,0 +1,210 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+
+#include <algorithm>
+#include <utility>
+#include <limits>
+#include "MeshOrdering.h"
+
+namespace voom
+{
+
+  namespace {
+
+    typedef unsigned long long Key;
+
+    //! Spread the low 21 bits of x to every third bit
+    Key spread3(Key x) {
+      x &= 0x1fffffULL;
+      x = (x | x << 32) & 0x1f00000000ffffULL;
+      x = (x | x << 16) & 0x1f0000ff0000ffULL;
+      x = (x | x << 8)  & 0x100f00f00f00f00fULL;
+      x = (x | x << 4)  & 0x10c30c30c30c30c3ULL;
+      x = (x | x << 2)  & 0x1249249249249249ULL;
+      return x;
+    }
+
+    Key morton(const unsigned int X[3]) {
+      return spread3(X[0]) << 2 | spread3(X[1]) << 1 | spread3(X[2]);
+    }
+
+    //! Hilbert index of X (bits per axis), Skilling's transpose method
+    Key hilbert(unsigned int X[3], int bits) {
+      const int n = 3;
+      unsigned int M = 1U << (bits-1), P, Q, t;
+      // inverse undo excess work
+      for(Q=M; Q>1; Q>>=1) {
+	P = Q-1;
+	for(int i=0; i<n; i++) {
+	  if( X[i] & Q ) X[0] ^= P;
+	  else { t = (X[0]^X[i]) & P; X[0] ^= t; X[i] ^= t; }
+	}
+      }
+      // Gray encode
+      for(int i=1; i<n; i++) X[i] ^= X[i-1];
+      t = 0;
+      for(Q=M; Q>1; Q>>=1) if( X[n-1] & Q ) t ^= Q-1;
+      for(int i=0; i<n; i++) X[i] ^= t;
+      // the transposed index interleaves to the Hilbert index
+      return morton(X);
+    }
+
+  }
+
+
+
+  void MeshOrdering::_compute(int nNodes, const std::vector<double> & xyz,
+			      const std::vector<int> & elementStart,
+			      const std::vector<int> & elementNodes) {
+    const int nElements = elementStart.size()-1;
+
+    // nodes
+    _nodeNewToOld.resize(nNodes);
+    for(int a=0; a<nNodes; a++) _nodeNewToOld[a] = a;
+    if( _method == RCM ) _reverseCuthillMcKee(nNodes, elementStart, elementNodes);
+    else if( _method == HILBERT || _method == MORTON ) _spaceFillingCurve(nNodes, xyz);
+    _nodeOldToNew.resize(nNodes);
+    for(int a=0; a<nNodes; a++) _nodeOldToNew[_nodeNewToOld[a]] = a;
+
+    // elements by lowest, then highest, renumbered node
+    std::vector< std::pair< std::pair<int,int>, int > > key(nElements);
+    for(int e=0; e<nElements; e++) {
+      int lo = nNodes, hi = -1;
+      for(int k=elementStart[e]; k<elementStart[e+1]; k++) {
+	const int n = _nodeOldToNew[elementNodes[k]];
+	lo = std::min(lo, n);
+	hi = std::max(hi, n);
+      }
+      key[e] = std::make_pair( std::make_pair(lo,hi), e );
+    }
+    if( _method != NONE ) std::sort(key.begin(), key.end());
+    _elementNewToOld.resize(nElements);
+    _elementOldToNew.resize(nElements);
+    for(int e=0; e<nElements; e++) {
+      _elementNewToOld[e] = key[e].second;
+      _elementOldToNew[key[e].second] = e;
+    }
+  }
+
+
+
+  /*!  Breadth first search from a pseudo-peripheral node, visiting
+    neighbors in order of increasing degree, repeated for every
+    connected component; the resulting order is reversed.  The start
+    node of each component is found by the George-Liu heuristic:
+    restart from a node of minimum degree on the last level of the
+    search until the number of levels stops growing.
+  */
+  void MeshOrdering::_reverseCuthillMcKee(int nNodes,
+					  const std::vector<int> & elementStart,
+					  const std::vector<int> & elementNodes) {
+    // node graph in compressed form
+    std::vector< std::vector<int> > neighbors(nNodes);
+    for(int e=0; e+1<elementStart.size(); e++) {
+      for(int i=elementStart[e]; i<elementStart[e+1]; i++) {
+	for(int j=elementStart[e]; j<elementStart[e+1]; j++) {
+	  if( elementNodes[i] != elementNodes[j] )
+	    neighbors[elementNodes[i]].push_back(elementNodes[j]);
+	}
+      }
+    }
+    std::vector<int> degree(nNodes);
+    for(int a=0; a<nNodes; a++) {
+      std::vector<int> & n = neighbors[a];
+      std::sort(n.begin(), n.end());
+      n.erase(std::unique(n.begin(), n.end()), n.end());
+      degree[a] = n.size();
+    }
+    for(int a=0; a<nNodes; a++) {
+      std::vector< std::pair<int,int> > byDegree(neighbors[a].size());
+      for(int k=0; k<neighbors[a].size(); k++)
+	byDegree[k] = std::make_pair(degree[neighbors[a][k]], neighbors[a][k]);
+      std::sort(byDegree.begin(), byDegree.end());
+      for(int k=0; k<byDegree.size(); k++) neighbors[a][k] = byDegree[k].second;
+    }
+
+    std::vector<int> order;
+    order.reserve(nNodes);
+    std::vector<int> level(nNodes, -1);
+    std::vector<char> numbered(nNodes, 0);
+    std::vector<int> queue;
+    queue.reserve(nNodes);
+
+    for(int seed=0; seed<nNodes; seed++) {
+      if( numbered[seed] ) continue;
+
+      // pseudo-peripheral start node of this component
+      int start = seed, depth = -1;
+      for(int pass=0; pass<8; pass++) {
+	queue.clear();
+	queue.push_back(start);
+	level[start] = 0;
+	for(int q=0; q<queue.size(); q++) {
+	  const int a = queue[q];
+	  for(int k=0; k<neighbors[a].size(); k++) {
+	    const int b = neighbors[a][k];
+	    if( level[b] < 0 ) { level[b] = level[a]+1; queue.push_back(b); }
+	  }
+	}
+	const int last = level[queue.back()];
+	int next = queue.back();
+	for(int q=queue.size()-1; q>=0 && level[queue[q]] == last; q--)
+	  if( degree[queue[q]] < degree[next] ) next = queue[q];
+	for(int q=0; q<queue.size(); q++) level[queue[q]] = -1;
+	if( last <= depth ) break;
+	depth = last;
+	start = next;
+      }
+
+      // Cuthill-McKee from start
+      const int first = order.size();
+      order.push_back(start);
+      numbered[start] = 1;
+      for(int q=first; q<order.size(); q++) {
+	const int a = order[q];
+	for(int k=0; k<neighbors[a].size(); k++) {
+	  const int b = neighbors[a][k];
+	  if( !numbered[b] ) { numbered[b] = 1; order.push_back(b); }
+	}
+      }
+    }
+
+    std::reverse(order.begin(), order.end());
+    _nodeNewToOld = order;
+  }
+
+
+
+  void MeshOrdering::_spaceFillingCurve(int nNodes, const std::vector<double> & xyz) {
+    if( nNodes == 0 ) return;
+    const int bits = 21;
+    double lo[3], hi[3];
+    for(int k=0; k<3; k++) lo[k] = hi[k] = xyz[k];
+    for(int a=0; a<nNodes; a++) {
+      for(int k=0; k<3; k++) {
+	lo[k] = std::min(lo[k], xyz[3*a+k]);
+	hi[k] = std::max(hi[k], xyz[3*a+k]);
+      }
+    }
+    // one scale for all axes keeps the curve isotropic
+    double extent = 0.0;
+    for(int k=0; k<3; k++) extent = std::max(extent, hi[k]-lo[k]);
+    const double scale = ( extent > 0.0 ? ((1U << bits) - 1)/extent : 0.0 );
+
+    std::vector< std::pair<Key,int> > key(nNodes);
+    for(int a=0; a<nNodes; a++) {
+      unsigned int X[3];
+      for(int k=0; k<3; k++) X[k] = (unsigned int)( (xyz[3*a+k]-lo[k])*scale );
+      key[a] = std::make_pair( _method == HILBERT ? hilbert(X, bits) : morton(X), a );
+    }
+    std::sort(key.begin(), key.end());
+    for(int a=0; a<nNodes; a++) _nodeNewToOld[a] = key[a].second;
+  }
+
+}; // namespace voom
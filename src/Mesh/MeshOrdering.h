@@ -0,0 +1,200 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+//
+// Reference:
+//  E. Cuthill and J. McKee, "Reducing the bandwidth of sparse
+//  symmetric matrices", Proc. 24th ACM National Conference (1969).
+//  A. George and J. W. H. Liu, Computer Solution of Large Sparse
+//  Positive Definite Systems, Prentice-Hall (1981).
+//  J. Skilling, "Programming the Hilbert curve", AIP Conf. Proc. 707
+//  (2004) 381-387.
+//
+/////////////////////////////////////////////////////////////////////////
+
+/*!
+  \file MeshOrdering.h
+
+  \brief Renumbering of mesh nodes and elements for memory locality.
+
+*/
+
+#if !defined(__MeshOrdering_h__)
+#define __MeshOrdering_h__
+
+#include <vector>
+#include <iterator>
+
+namespace voom
+{
+
+  /*!  Meshes are read in file order, so the element loops of the
+    bodies (C0MembraneBody, LoopShellBody, Body3D, ...) gather node
+    points and scatter forces all over memory.  MeshOrdering computes
+    a node permutation that places nearby nodes next to each other --
+    reverse Cuthill-McKee on the node graph of the connectivity, or a
+    Hilbert or Morton space filling curve through the node positions
+    -- and orders the elements by their lowest renumbered node, so
+    that consecutive elements touch consecutive nodes.
+
+    Typical use, before the nodes and bodies are built:
+    \code
+    MeshOrdering order(MeshOrdering::HILBERT);
+    order.compute(points, connectivities);
+    order.permuteNodes(points);                // points in the new order
+    order.renumberConnectivities(connectivities);
+    // ... create nodes, dof indices and bodies as usual ...
+    order.restoreNodes(result);                // output in file order
+    \endcode
+    If the nodes already exist, renumberNodes() reorders the node
+    container and reassigns ids and contiguous dof indices instead.
+
+    Point_t and Connectivity_t may be any container with begin() and
+    end() (tvmet::Vector, std::vector, ...).
+  */
+  class MeshOrdering
+  {
+  public:
+
+    enum Method { NONE, RCM, HILBERT, MORTON };
+
+    MeshOrdering(Method method=HILBERT) : _method(method) {}
+
+    //! Compute the node and element permutations
+    template<class Point_t, class Connectivity_t>
+    void compute(const std::vector<Point_t> & points,
+		 const std::vector<Connectivity_t> & connectivities);
+
+    //! Permutation arrays: newToOld[new] = old, oldToNew[old] = new
+    const std::vector<int> & nodeNewToOld() const { return _nodeNewToOld; }
+    const std::vector<int> & nodeOldToNew() const { return _nodeOldToNew; }
+    const std::vector<int> & elementNewToOld() const { return _elementNewToOld; }
+    const std::vector<int> & elementOldToNew() const { return _elementOldToNew; }
+
+    //! Reorder per node data (points, nodes, ...) into the new order
+    template<class T>
+    void permuteNodes(std::vector<T> & data) const { _permute(data, _nodeNewToOld); }
+
+    //! Reorder per element data into the new order
+    template<class T>
+    void permuteElements(std::vector<T> & data) const { _permute(data, _elementNewToOld); }
+
+    //! Map per node data in the new order back to file order
+    template<class T>
+    void restoreNodes(std::vector<T> & data) const { _permute(data, _nodeOldToNew); }
+
+    //! Map per element data in the new order back to file order
+    template<class T>
+    void restoreElements(std::vector<T> & data) const { _permute(data, _elementOldToNew); }
+
+    //! Reorder the elements and relabel their nodes
+    template<class Connectivity_t>
+    void renumberConnectivities(std::vector<Connectivity_t> & connectivities) const;
+
+    //! Reorder existing nodes, setting ids and contiguous dof indices
+    /*! Node_t needs the NodeBase interface (index(), setIndex(), setId()). */
+    template<class Node_t>
+    void renumberNodes(std::vector<Node_t*> & nodes) const;
+
+    //! Node bandwidth max |new(a) - new(b)| over the elements, to compare orderings
+    template<class Connectivity_t>
+    int bandwidth(const std::vector<Connectivity_t> & connectivities) const;
+
+  private:
+
+    Method _method;
+    std::vector<int> _nodeNewToOld, _nodeOldToNew;
+    std::vector<int> _elementNewToOld, _elementOldToNew;
+
+    //! Order the nodes; elements given in compressed form
+    void _compute(int nNodes, const std::vector<double> & xyz,
+		  const std::vector<int> & elementStart,
+		  const std::vector<int> & elementNodes);
+
+    void _reverseCuthillMcKee(int nNodes,
+			      const std::vector<int> & elementStart,
+			      const std::vector<int> & elementNodes);
+
+    void _spaceFillingCurve(int nNodes, const std::vector<double> & xyz);
+
+    template<class T>
+    static void _permute(std::vector<T> & data, const std::vector<int> & map) {
+      if( map.size() != data.size() ) return;
+      std::vector<T> copy(data);
+      for(int i=0; i<map.size(); i++) data[i] = copy[map[i]];
+    }
+  };
+
+
+
+  template<class Point_t, class Connectivity_t>
+  void MeshOrdering::compute(const std::vector<Point_t> & points,
+			     const std::vector<Connectivity_t> & connectivities) {
+    const int nNodes = points.size();
+    std::vector<double> xyz(3*nNodes, 0.0);
+    for(int a=0; a<nNodes; a++) {
+      int k = 0;
+      for(typename Point_t::const_iterator x=points[a].begin();
+	  x!=points[a].end() && k<3; x++, k++) xyz[3*a+k] = *x;
+    }
+    std::vector<int> elementStart(1,0), elementNodes;
+    for(int e=0; e<connectivities.size(); e++) {
+      elementNodes.insert(elementNodes.end(),
+			  connectivities[e].begin(), connectivities[e].end());
+      elementStart.push_back(elementNodes.size());
+    }
+    _compute(nNodes, xyz, elementStart, elementNodes);
+  }
+
+
+
+  template<class Connectivity_t>
+  void MeshOrdering::renumberConnectivities(std::vector<Connectivity_t> & connectivities) const {
+    if( _elementNewToOld.size() != connectivities.size() ) return;
+    for(int e=0; e<connectivities.size(); e++) {
+      for(typename Connectivity_t::iterator a=connectivities[e].begin();
+	  a!=connectivities[e].end(); a++) *a = _nodeOldToNew[*a];
+    }
+    permuteElements(connectivities);
+  }
+
+
+
+  template<class Node_t>
+  void MeshOrdering::renumberNodes(std::vector<Node_t*> & nodes) const {
+    permuteNodes(nodes);
+    int dof = 0;
+    for(int a=0; a<nodes.size(); a++) {
+      std::vector<int> index( nodes[a]->index() );
+      for(int i=0; i<index.size(); i++) index[i] = dof++;
+      nodes[a]->setIndex(index);
+      nodes[a]->setId(a);
+    }
+  }
+
+
+
+  template<class Connectivity_t>
+  int MeshOrdering::bandwidth(const std::vector<Connectivity_t> & connectivities) const {
+    int b = 0;
+    for(int e=0; e<connectivities.size(); e++) {
+      int lo = -1, hi = -1;
+      for(typename Connectivity_t::const_iterator a=connectivities[e].begin();
+	  a!=connectivities[e].end(); a++) {
+	const int n = ( _nodeOldToNew.empty() ? *a : _nodeOldToNew[*a] );
+	if( lo < 0 || n < lo ) lo = n;
+	if( n > hi ) hi = n;
+      }
+      if( hi - lo > b ) b = hi - lo;
+    }
+    return b;
+  }
+
+}; // namespace voom
+
+#endif // __MeshOrdering_h__
@@ -0,0 +1,85 @@
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <cmath>
+#include "MeshOrdering.h"
+
+using namespace voom;
+
+//! mean distance between consecutively numbered nodes
+double meanStep(const std::vector< std::vector<double> > & X) {
+  double s = 0.0;
+  for(int a=1; a<X.size(); a++) {
+    double d = 0.0;
+    for(int k=0; k<3; k++) d += (X[a][k]-X[a-1][k])*(X[a][k]-X[a-1][k]);
+    s += std::sqrt(d);
+  }
+  return s/(X.size()-1);
+}
+
+int main(){
+
+  // triangulated n x n grid with randomly shuffled node numbers
+  const int n = 40;
+  std::vector<int> label(n*n);
+  for(int a=0; a<n*n; a++) label[a] = a;
+  srand(17);
+  for(int a=n*n-1; a>0; a--) std::swap(label[a], label[rand()%(a+1)]);
+
+  std::vector< std::vector<double> > X(n*n, std::vector<double>(3,0.0));
+  for(int i=0; i<n; i++)
+    for(int j=0; j<n; j++) {
+      X[label[i*n+j]][0] = i;
+      X[label[i*n+j]][1] = j;
+    }
+  std::vector< std::vector<int> > connect;
+  for(int i=0; i+1<n; i++)
+    for(int j=0; j+1<n; j++) {
+      std::vector<int> c(3);
+      c[0] = label[i*n+j]; c[1] = label[(i+1)*n+j]; c[2] = label[(i+1)*n+j+1];
+      connect.push_back(c);
+      c[1] = label[(i+1)*n+j+1]; c[2] = label[i*n+j+1];
+      connect.push_back(c);
+    }
+
+  MeshOrdering none(MeshOrdering::NONE);
+  none.compute(X, connect);
+  const int b0 = none.bandwidth(connect);
+  const double s0 = meanStep(X);
+
+  bool passed = true;
+  MeshOrdering::Method methods[3] = {MeshOrdering::RCM, MeshOrdering::HILBERT, MeshOrdering::MORTON};
+  const char * names[3] = {"RCM", "Hilbert", "Morton"};
+  for(int m=0; m<3; m++) {
+    MeshOrdering order(methods[m]);
+    order.compute(X, connect);
+
+    std::vector< std::vector<double> > Y(X);
+    std::vector< std::vector<int> > C(connect);
+    order.permuteNodes(Y);
+    order.renumberConnectivities(C);
+
+    // the renumbered mesh is the same mesh
+    for(int e=0; e<C.size(); e++) {
+      const int e0 = order.elementNewToOld()[e];
+      for(int k=0; k<3; k++)
+	if( Y[C[e][k]] != X[connect[e0][k]] ) passed = false;
+    }
+    // and maps back
+    std::vector< std::vector<double> > Z(Y);
+    order.restoreNodes(Z);
+    if( Z != X ) passed = false;
+
+    const int b = order.bandwidth(connect);
+    const double s = meanStep(Y);
+    std::cout << names[m] << ": bandwidth " << b0 << " -> " << b
+	      << ", mean step " << s0 << " -> " << s << std::endl;
+    // RCM minimizes bandwidth, the curves keep neighbors close
+    if( methods[m] == MeshOrdering::RCM && b >= b0/10 ) passed = false;
+    if( s >= s0/5 ) passed = false;
+  }
+  
+  if( passed ) std::cout << "MeshOrdering test PASSED!" << std::endl;
+  else std::cout << "MeshOrdering test FAILED!" << std::endl;
+  return 0;
+}
@@ -18,9 +18,12 @@
 //----------------------------------------------------------------------
 #include<time.h>
 #include <fstream>
+#include <algorithm>
+#include <set>
 #include<blitz/array-impl.h>
 #include "Model.h"
 #include "Solver.h"
+#include "Lanczos.h"
 
 // LAPACK FORTRAN subroutine for computing eigenvalues and eigenvectors
 extern "C" void dsyev_(char *jobz, char *uplo, int *n, double *a, int *lda,
@@ -37,6 +40,7 @@ namespace voom
 {
   
   Model::Model( const BodyContainer & bodies, const NodeContainer & nodes )
+    : _bound(false)
   {
     _bodies = bodies;
     _nodes = nodes;
@@ -60,6 +64,7 @@ namespace voom
   }
   
   Model::Model( const NodeContainer & nodes )
+    : _bound(false)
   {
     _nodes = nodes;
     std::cout << std::setw(15)<<"Building Model from "
@@ -79,6 +84,120 @@ namespace voom
     
   }
   
+  bool Model::bindStorage() {
+    if(_bound) return true;
+    if(_dof == 0) return false;
+
+    // every dof index must belong to exactly one node
+    std::vector<bool> seen(_dof, false);
+    for(ConstNodeIterator n=_nodes.begin(); n!=_nodes.end(); n++) {
+      const NodeBase::DofIndexMap & idx = (*n)->index();
+      for(int i=0; i<idx.size(); i++) {
+	if(idx[i] < 0 || idx[i] >= _dof || seen[idx[i]]) return false;
+	seen[idx[i]] = true;
+      }
+    }
+
+    _field.assign(_dof, 0.0);
+    _force.assign(_dof, 0.0);
+    for(NodeIterator n=_nodes.begin(); n!=_nodes.end(); n++) {
+      if( !(*n)->bindStorage(&_field[0], &_force[0]) ) {
+	std::cout << "Model: node " << (*n)->id() 
+		  << " cannot use contiguous storage." << std::endl;
+	for(NodeIterator m=_nodes.begin(); m!=n; m++) (*m)->unbindStorage();
+	_field.clear();
+	_force.clear();
+	return false;
+      }
+    }
+    _bound = true;
+    return true;
+  }
+
+  void Model::unbindStorage() {
+    if(!_bound) return;
+    for(NodeIterator n=_nodes.begin(); n!=_nodes.end(); n++) 
+      (*n)->unbindStorage();
+    _field.clear();
+    _force.clear();
+    _bound = false;
+  }
+
+  void Model::buildSparsity(SparseMatrix & K) {
+    std::set<const NodeBase*> active(_nodes.begin(), _nodes.end());
+
+    // one group of coupled dof per element
+    std::vector< std::vector<int> > groups;
+    _elementDof.clear();
+    _sparsityConnectivity.clear();
+    for(ConstBodyIterator b=_bodies.begin(); b!=_bodies.end(); b++) {
+      const Body::ElementContainer & elements = (*b)->elements();
+      for(Body::ConstElementIterator e=elements.begin(); e!=elements.end(); e++) {
+	std::vector<int> idx;
+	const Element::BaseNodeContainer & nodes = (*e)->baseNodes();
+	for(Element::ConstBaseNodeIterator n=nodes.begin(); n!=nodes.end(); n++) {
+	  const bool isActive = ( active.find(*n) != active.end() );
+	  for(int i=0; i<(*n)->dof(); i++) {
+	    _elementDof.push_back( isActive ? (*n)->index()[i] : -1 );
+	    if(isActive) idx.push_back( (*n)->index()[i] );
+	  }
+	}
+	if(idx.size() > 0) groups.push_back(idx);
+      }
+      _sparsityConnectivity.push_back( (*b)->connectivity() );
+      _sparsityConnectivity.push_back( elements.size() );
+    }
+
+    // nodes may be coupled within themselves without any element
+    // (nodal stiffness of constraints and of bodies without elements)
+    for(ConstNodeIterator n=_nodes.begin(); n!=_nodes.end(); n++)
+      groups.push_back( (*n)->index() );
+
+    K.setPattern(_dof, groups);
+    std::cout << "Model: sparse stiffness with " << K.nonZeros()
+	      << " nonzeros for " << _dof << " dof." << std::endl;
+    return;
+  }
+
+  bool Model::_sparsityChanged() const {
+    if(_sparsityConnectivity.size() != 2*_bodies.size()) return true;
+    for(int b=0; b<_bodies.size(); b++) {
+      if( _sparsityConnectivity[2*b] != _bodies[b]->connectivity() ||
+	  _sparsityConnectivity[2*b+1] != _bodies[b]->elements().size() ) 
+	return true;
+    }
+    return false;
+  }
+
+  bool Model::assembleStiffness(SparseMatrix & K) {
+    K.zero();
+    std::vector<double> & values = K.values();
+    blitz::Array<double,2> ke;
+    int k=0;
+    for(BodyIterator b=_bodies.begin(); b!=_bodies.end(); b++) {
+      Body::ElementContainer & elements = (*b)->elements();
+      // Element stiffness may perturb shared nodes, so this loop is serial.
+      for(Body::ElementIterator e=elements.begin(); e!=elements.end(); e++) {
+	const int n = (*e)->baseDof();
+	if(n == 0) continue;
+	if(k+n > _elementDof.size()) return false;
+	(*e)->stiffness(ke);
+	const int * idx = &_elementDof[k];
+	for(int ai=0; ai<n; ai++) {
+	  if(idx[ai] < 0) continue;
+	  for(int bj=0; bj<n; bj++) {
+	    if(idx[bj] < 0) continue;
+	    const int p = K.find( idx[ai], idx[bj] );
+	    if(p < 0) return false;
+	    values[p] += ke(ai,bj);
+	  }
+	}
+	k += n;
+      }
+    }
+    return ( k == _elementDof.size() );
+  }
+
   //! check consistency of derivatives
   bool Model::checkConsistency(bool f1, bool f2) {
     
@@ -271,14 +390,14 @@ namespace voom
     int  lda  = n;
     int  lwork = 3*n-1;
     int  info;
-    double eigenvalues[_dof];
-    double work[lwork];
+    std::vector<double> eigenvalues(_dof);
+    std::vector<double> work(lwork);
     
     blitz::Array<double,2> & k = solver._DDE;
     // calling lapack function here to compute
     // eigenvalues and eigenvectors of k
     dsyev_(&jobz, &uplo, &n, k.data(),
-           &lda, eigenvalues, work, &lwork, &info);
+           &lda, &eigenvalues[0], &work[0], &lwork, &info);
 
 
     if (info != 0) {
@@ -319,214 +438,195 @@ namespace voom
 
   }
   
-  void Model::normalModes(bool eigenvectors, int nmodes, std::string filename) {
+  namespace {
+
+    //! Mass-weighted stiffness M^-1/2 K M^-1/2 applied as a product
+    /*! K v is either an assembled sparse stiffness times v, or, when
+      no stiffness is assembled, a central difference of the gradient
+      along v, which costs two gradient evaluations and works for any
+      body.
+    */
+    class ModelHessian : public SymmetricOperator
+    {
+    public:
+      ModelHessian(Model * model, const blitz::Array<double,1> & mass, bool assembled):
+	_model(model), _invSqrtMass(mass.size()), _assembled(assembled) {
+	const int n = mass.size();
+	for(int i=0; i<n; i++) _invSqrtMass(i) = 1.0/std::sqrt(mass(i));
+	_storage.resize(n);
+	_model->getField(_storage);
+	_x0.resize(n);
+	_x0 = _storage._x;
+	_u.resize(n);
+	_scale = std::max(1.0, blitz::max(blitz::abs(_x0)));
+	if(_assembled) _model->computeAndAssemble(_storage, false, false, true);
+      }
 
-    bool verbose = false;
-    //for time calculation
-    time_t start,end;
-    double duration=0.;
+      ~ModelHessian() {
+	// leave the model where we found it
+	_storage._x = _x0;
+	_model->putField(_storage);
+      }
 
-    std::cout << "Entered the normal mode calculation." << std::endl;
-    Storage solver;
-    solver.resize(this->dof());
+      int size() const { return _invSqrtMass.size(); }
+
+      void multiply(const double * x, double * y) {
+	const int n = size();
+	for(int i=0; i<n; i++) _u(i) = _invSqrtMass(i)*x[i];
+	if(_assembled) {
+	  _storage._DDE.multiply(_u.data(), y);
+	} else {
+	  const double h = 1.0e-6*_scale/std::max(blitz::max(blitz::abs(_u)), 1.0e-300);
+	  _storage._x = _x0 + h*_u;
+	  _model->putField(_storage);
+	  _model->computeAndAssemble(_storage, false, true, false);
+	  for(int i=0; i<n; i++) y[i] = _storage._DE(i);
+	  _storage._x = _x0 - h*_u;
+	  _model->putField(_storage);
+	  _model->computeAndAssemble(_storage, false, true, false);
+	  for(int i=0; i<n; i++) y[i] = (y[i] - _storage._DE(i))/(2.0*h);
+	}
+	for(int i=0; i<n; i++) y[i] *= _invSqrtMass(i);
+      }
 
-    blitz::Array<double,2> k_n(_dof,_dof);
-    k_n = 0.0;
-    getField(solver);
-    blitz::Array<double,1>& x = solver._x;
+    private:
+      Model * _model;
+      blitz::Array<double,1> _invSqrtMass;
+      bool _assembled;
+      SparseStorage _storage;
+      blitz::Array<double,1> _x0;
+      blitz::Array<double,1> _u;
+      double _scale;
+    };
 
-    const double h = 1.0e-8*blitz::max(blitz::abs(x));
+  }
 
-    // numerical force and stiffness
-    blitz::Range all = blitz::Range::all();
-    for (int i = 0 ; i < _dof; i++) {
-      if (verbose) std::cout << " i = " << i << std::endl;
-      x(i) += h; 
-      putField(solver);
-      computeAndAssemble(solver, false, true, false);
-      k_n(i,all) = solver._DE;
+  void Model::_lumpedMass(const std::vector<double> * weight, double dens,
+			  blitz::Array<double,1> & mass) const {
+    mass.resize(_dof);
+    if(weight == 0) {
+      mass = 1.0;
+      return;
+    }
+    // three dof per weighted node; any further dof (nodes without a
+    // weight, non-displacement dof) get the mean nodal mass
+    const int covered = std::min(3*int(weight->size()), _dof);
+    double mean = 0.0;
+    for(int i=0; i<covered; i++) {
+      mass(i) = (*weight)[i/3]*dens;
+      mean += mass(i);
+    }
+    mean = (covered > 0 ? mean/covered : 1.0);
+    for(int i=covered; i<_dof; i++) mass(i) = mean;
+  }
 
-      x(i) -= 2.0*h; putField(solver);
-      computeAndAssemble(solver, false, true, false);
-      k_n(i,all) -= solver._DE;
-  
-      x(i) += h; putField(solver);
+  void Model::rigidBodyModes(const blitz::Array<double,1> & mass,
+			     std::vector<double> & modes) const {
+    // centroid of the nodes with three translational dof
+    double c[3] = {0.0, 0.0, 0.0};
+    int count = 0;
+    for(ConstNodeIterator n=_nodes.begin(); n!=_nodes.end(); n++) {
+      if((*n)->dof() != 3) continue;
+      for(int k=0; k<3; k++) c[k] += (*n)->getPoint(k);
+      count++;
+    }
+    modes.clear();
+    if(count == 0) return;
+    for(int k=0; k<3; k++) c[k] /= count;
+
+    // three translations, then rotations about the centroid
+    modes.assign(6*_dof, 0.0);
+    for(ConstNodeIterator n=_nodes.begin(); n!=_nodes.end(); n++) {
+      if((*n)->dof() != 3) continue;
+      const NodeBase::DofIndexMap & idx = (*n)->index();
+      double x[3];
+      for(int k=0; k<3; k++) x[k] = (*n)->getPoint(k) - c[k];
+      for(int k=0; k<3; k++) modes[k*_dof + idx[k]] = 1.0;
+      modes[3*_dof + idx[1]] = -x[2]; modes[3*_dof + idx[2]] =  x[1];
+      modes[4*_dof + idx[0]] =  x[2]; modes[4*_dof + idx[2]] = -x[0];
+      modes[5*_dof + idx[0]] = -x[1]; modes[5*_dof + idx[1]] =  x[0];
     }
-    k_n /= 2.0*h;
 
-    solver._DDE = 0.5*(k_n + k_n.transpose(blitz::secondDim,blitz::firstDim));
+    // mass-weighted coordinates v = M^1/2 u
+    for(int m=0; m<6; m++)
+      for(int i=0; i<_dof; i++) modes[m*_dof + i] *= std::sqrt(mass(i));
+    orthonormalize(modes, _dof);
+  }
 
-    std::cout << "Stiffness matrix calculated. Calculating eigenvalues." << std::endl;
+  int Model::normalModesLanczos(int nmodes, std::vector<double> & eigenvalues,
+				std::vector<double> * modes,
+				const std::vector<double> * weight, double dens,
+				bool deflateRigid, bool assembled, double tol,
+				int blockSize) {
+    time_t start, end;
+    time(&start);
 
-    // compute Eigenvalues and Eigenvectors by calling LAPACK library
-    char jobz;
-    if (eigenvectors) jobz = 'V';
-    else jobz = 'N';
+    blitz::Array<double,1> mass;
+    _lumpedMass(weight, dens, mass);
 
-    char range = 'I';
-    char uplo = 'L';
-    int n = _dof;
-    int lda = n;
-    double VL, VU;
-    int il=1, iu=nmodes, M;
-    double ABSTOL=0.;
-    int lwork = 8*n;
-    int info;
-    double eigenvalues[_dof];
-    double work[lwork];
-    int IWORK[5*n];
-    int IFAIL[n];
-    blitz::Array<double,2> Z(nmodes,n);
-    int ITYPE=1;
-    //stiffness matrix
-    blitz::Array<double,2>& k = solver._DDE;
+    std::vector<double> rigid;
+    if(deflateRigid) rigidBodyModes(mass, rigid);
 
-    // calling lapack function here to compute
-    // eigenvalues and eigenvectors of inv(m)*k
-    
-    time(&start);
-    dsyevx_( &jobz, &range , &uplo, &n, k.data(), &lda, &VL, &VU, &il, &iu,
-     &ABSTOL, &M, eigenvalues, Z.data(), &n, work, &lwork, IWORK,
-     IFAIL, &info );
-//    dsygvx_(&ITYPE, &jobz, &range, &uplo, &n, k.data(), &lda, mass.data(), &lda,
-  //       &VL, &VU, &il, &iu, &ABSTOL, &M,
-    //      eigenvalues, Z.data(), &n , work, &lwork, IWORK, IFAIL, &info );
-    time(&end);
-    duration = difftime(end,start);
-    std::cout <<"Time taken for eigenvalue decomposition is "<<duration<<" seconds."<<std::endl;
-    if (info != 0) {
-      std::cout << "Something is wrong in DSYEV_" << std::endl;
-      exit(0);
+    ModelHessian H(this, mass, assembled);
+    const int nconv = lanczos(H, nmodes, eigenvalues, modes, rigid, tol, 100, -1, blockSize);
+
+    // back to physical displacements u = M^-1/2 v
+    if(modes) {
+      const int m = eigenvalues.size();
+      for(int k=0; k<m; k++)
+	for(int i=0; i<_dof; i++) (*modes)[k*_dof + i] /= std::sqrt(mass(i));
     }
-//print out the eigenvectors
+
+    time(&end);
+    std::cout << "Lanczos: " << nconv << " of " << nmodes << " modes converged in "
+	      << difftime(end,start) << " seconds." << std::endl;
+    return nconv;
+  }
+
+  void Model::_printModes(bool eigenvectors, const std::vector<double> & eigenvalues,
+			  const std::vector<double> & modes, std::string filename) {
+    const int nmodes = eigenvalues.size();
     if (eigenvectors) {
-      for (int i = 0; i < nmodes; i++) { 
-        double h = 1.;//0.3/blitz::max(Z(i,blitz::Range::all()));
-        solver._x += h*Z(i,blitz::Range::all());
+      Storage solver;
+      solver.resize(this->dof());
+      getField(solver);
+      for (int i = 0; i < nmodes; i++) {
+	blitz::Array<double,1> Z(const_cast<double*>(&modes[i*_dof]), blitz::shape(_dof),
+				 blitz::neverDeleteData);
+        solver._x += Z;
         putField(solver);
         char name[20];
         std::string fname = filename;
         sprintf(name,"evec%d",i);
         fname += name;
         print(fname);
-        solver._x -= h*Z(i,blitz::Range::all());
+        solver._x -= Z;
       }
+      putField(solver);
     }
     std::cout<<"The eigenfrequencies are:"<<std::endl;
     for (int i = 0; i < nmodes; i++) 
       std::cout << "eval[" << std::setw((int)std::ceil(log10(_dof))) << i << "]="
                 << eigenvalues[i] << std::endl;
   }
-  void Model::normalModes(bool eigenvectors, int nmodes, std::vector<double> &weight, double dens, std::string filename) {
 
-    bool verbose = false;
-    //for time calculation
-    time_t start,end;
-    double duration=0.;
+  void Model::normalModes(bool eigenvectors, int nmodes, std::string filename) {
 
     std::cout << "Entered the normal mode calculation." << std::endl;
-    Storage solver;
-    solver.resize(this->dof());
-
-    blitz::Array<double,2> k_n(_dof,_dof);
-    k_n = 0.0;
-    getField(solver);
-    blitz::Array<double,1>& x = solver._x;
-
-    const double h = 1.0e-8*blitz::max(blitz::abs(x));
-
-    // numerical force and stiffness
-    blitz::Range all = blitz::Range::all();
-    for (int i = 0 ; i < _dof; i++) {
-      if (verbose) std::cout << " i = " << i << std::endl;
-      x(i) += h; 
-      putField(solver);
-      computeAndAssemble(solver, false, true, false);
-      k_n(i,all) = solver._DE;
-
-      x(i) -= 2.0*h; putField(solver);
-      computeAndAssemble(solver, false, true, false);
-      k_n(i,all) -= solver._DE;
-  
-      x(i) += h; putField(solver);
-    }
-    k_n /= 2.0*h;
-
-    solver._DDE = 0.5*(k_n + k_n.transpose(blitz::secondDim,blitz::firstDim));
-
-    std::cout << "Stiffness matrix calculated. Calculating eigenvalues." << std::endl;
-
-    // compute Eigenvalues and Eigenvectors by calling LAPACK library
-    char jobz;
-    if (eigenvectors) jobz = 'V';
-    else jobz = 'N';
-
-    char range = 'I';
-    char uplo = 'L';
-    int n = _dof;
-    int lda = n;
-    double VL, VU;
-    int il=1, iu=nmodes, M;
-    double ABSTOL=0.;
-    int lwork = 8*n;
-    int info;
-    double eigenvalues[_dof];
-    double work[lwork];
-    int IWORK[5*n];
-    int IFAIL[n];
-    blitz::Array<double,2> Z(nmodes,n);
-    int ITYPE=1;
-    //stiffness matrix
-    blitz::Array<double,2>& k = solver._DDE;
+    std::vector<double> eigenvalues, modes;
+    normalModesLanczos(nmodes, eigenvalues, (eigenvectors ? &modes : 0), 0, 1.0, false);
+    _printModes(eigenvectors, eigenvalues, modes, filename);
+  }
 
-    //mass matrix
-    blitz::Array<double,1> mass(_dof);
-    mass=0;
-    for(int i=0;i<weight.size();i++)
-       {mass(3*i) = mass(3*i+1) = mass(3*i+2) = weight[i]*dens;}
-    //transform K -> M^(-1/2)*K*M^(-1/2) where M is lumped mass matrix
-    for(int i=0;i<_dof;i++)
-       for(int j=0;j<_dof;j++)
-          k(i,j)=k(i,j)/sqrt(mass(i))/sqrt(mass(j));
+  void Model::normalModes(bool eigenvectors, int nmodes, std::vector<double> &weight, double dens, std::string filename) {
 
-    // calling lapack function here to compute
-    // eigenvalues and eigenvectors of inv(m)*k
-    
-    time(&start);
-    dsyevx_( &jobz, &range , &uplo, &n, k.data(), &lda, &VL, &VU, &il, &iu,
-     &ABSTOL, &M, eigenvalues, Z.data(), &n, work, &lwork, IWORK,
-     IFAIL, &info );
-    time(&end);
-    duration = difftime(end,start);
-    std::cout <<"Time taken for eigenvalue decomposition is "<<duration<<" seconds."<<std::endl;
-    if (info != 0) {
-      std::cout << "Something is wrong in DSYEV_" << std::endl;
-      exit(0);
-    }
-//print out the eigenvectors
-    if (eigenvectors) {
-      //take off the mass matrix from the eigenvectors
-      for (int i=0;i<_dof;i++)
-          Z(blitz::Range::all(),i) /= sqrt(mass(i));
-      for (int i = 0; i < nmodes; i++) { 
-        double h = 1.;//0.3/blitz::max(Z(i,blitz::Range::all()));
-        solver._x += h*Z(i,blitz::Range::all());
-        putField(solver);
-        char name[20];
-        std::string fname = filename;
-        sprintf(name,"evec%d",i);
-        fname += name;
-        print(fname);
-        solver._x -= h*Z(i,blitz::Range::all());
-      }
-    }
-    std::cout<<"The eigenfrequencies are:"<<std::endl;
-    for (int i = 0; i < nmodes; i++) 
-      std::cout << "eval[" << std::setw((int)std::ceil(log10(_dof))) << i << "]="
-                << eigenvalues[i] << std::endl;
+    std::cout << "Entered the normal mode calculation." << std::endl;
+    std::vector<double> eigenvalues, modes;
+    normalModesLanczos(nmodes, eigenvalues, (eigenvectors ? &modes : 0), &weight, dens, false);
+    _printModes(eigenvectors, eigenvalues, modes, filename);
     std::ofstream evals;
     evals.open("evals.dat");
-    for (int i = 0; i < nmodes; i++) 
+    for (int i = 0; i < eigenvalues.size(); i++) 
       evals << eigenvalues[i] << std::endl;
     evals.close();
   }
@@ -581,8 +681,8 @@ namespace voom
     int lda = n;
     int lwork = 3*n-1;
     int info;
-    double eigenvalues[_dof];
-    double work[lwork];
+    std::vector<double> eigenvalues(_dof);
+    std::vector<double> work(lwork);
     time(&start);    
     blitz::Array<double,2>& k = solver._DDE;
 
@@ -597,7 +697,7 @@ namespace voom
           k(i,j)=k(i,j)/sqrt(mass(i))/sqrt(mass(j));
     //std::cout<<"Mass matrix not used. Only an identity matrix assumed."<<std::endl;
     // calling lapack function here to compute
-    dsyev_(&jobz, &uplo, &n, k.data(), &lda, eigenvalues, work, &lwork, &info);
+    dsyev_(&jobz, &uplo, &n, k.data(), &lda, &eigenvalues[0], &work[0], &lwork, &info);
     time(&end);
     duration=difftime(end,start);
     std::cout<<"Time taken for eigenvalue decomposition is "<<duration<<" seconds."<<std::endl;
@@ -680,13 +780,13 @@ namespace voom
     int lda = n;
     int lwork = 3*n-1;
     int info;
-    double eigenvalues[_dof];
-    double work[lwork];
+    std::vector<double> eigenvalues(_dof);
+    std::vector<double> work(lwork);
     time(&start);    
     blitz::Array<double,2>& k = solver._DDE;
     
     // calling lapack function here to compute
-    dsyev_(&jobz, &uplo, &n, k.data(), &lda, eigenvalues, work, &lwork, &info);
+    dsyev_(&jobz, &uplo, &n, k.data(), &lda, &eigenvalues[0], &work[0], &lwork, &info);
     time(&end);
     duration=difftime(end,start);
     std::cout<<"Time taken for eigenvalue decomposition is "<<duration<<" seconds."<<std::endl;
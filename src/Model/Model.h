@@ -36,11 +36,14 @@
 
 #include<blitz/array.h>
 #include<vector>
+#include<algorithm>
 #include "voom.h"
 #include "NodeBase.h"
 #include "Body.h"
 #include "Element.h"
 #include "Constraint.h"
+#include "SparseMatrix.h"
+#include "Profiler.h"
 
 #ifdef WITH_MPI
 #include <mpi.h>
@@ -70,12 +73,36 @@ namespace voom
     typedef ConstraintContainer::const_iterator ConstConstraintIterator;
     
     //! Default Constructor
-    Model() {};
+    Model() : _dof(0), _bound(false) {};
 
     Model( const BodyContainer & bodies, const NodeContainer & nodes );
 
     Model( const NodeContainer & nodes );
 
+    //! Destructor; nodes get their own storage back
+    ~Model() { unbindStorage(); }
+
+    //! Opt-in contiguous dof storage
+    /*! The model allocates one field array and one force array, both
+      indexed by global dof, and makes every node's point and force a
+      view into them (NodeBase::bindStorage).  getField, putField and
+      the force copy in computeAndAssemble then skip the per-dof
+      virtual calls, and are no-ops for solvers whose field and
+      gradient arrays are these arrays (see Solver::fieldData).
+      Succeeds only if every node can be bound and dof indices are
+      unique; otherwise nothing is changed and false is returned.
+    */
+    bool bindStorage();
+
+    //! Nodes return to their own storage
+    void unbindStorage();
+
+    bool storageBound() const { return _bound; }
+
+    //! Contiguous field and force arrays (valid while bound)
+    double * fieldData() { return &_field[0]; }
+    double * forceData() { return &_force[0]; }
+
     template<class Solver_t>
     void getField(Solver_t & solver) const;
 
@@ -89,6 +116,21 @@ namespace voom
     template<class Solver_t>
     void computeAndAssemble( Solver_t & solver, bool f0, bool f1, bool f2 );
 
+    //! Build the sparsity pattern of the global stiffness
+    /*! The pattern couples all dof of the model nodes that share an
+      element, and all dof of each node.  computeAndAssemble rebuilds
+      it whenever a body reports changed connectivity (see
+      Body::connectivity).
+    */
+    void buildSparsity(SparseMatrix & K);
+
+    //! Assemble element stiffness matrices into K
+    /*! Returns false, leaving K incomplete, if an element couples dof
+      outside of the pattern or the elements changed since
+      buildSparsity; the pattern must then be rebuilt.
+    */
+    bool assembleStiffness(SparseMatrix & K);
+
     //! Get the number of degrees of freedom in the model
     const int dof() const {return _dof;} 
 
@@ -107,6 +149,33 @@ namespace voom
 
     void normalModes(bool eigenvectors, int nmodes, std::string filename);
 
+    //! Lowest nmodes normal modes by Lanczos iteration
+    /*! Solves K u = lambda M u for the lowest nmodes eigenpairs using
+      only stiffness-vector products, so no dense stiffness is ever
+      formed.  M is the lumped mass weight[i]*dens on the three dof of
+      node i (identity if weight is null); dof not covered by weight
+      get the mean of the weighted masses.  With assembled=false the
+      product is a central difference of the gradient (two
+      computeAndAssemble calls per product, valid for any body); with
+      assembled=true the sparse element stiffness is assembled once.
+      If deflateRigid is set the six rigid-body modes are projected
+      out and the lowest deformation modes are returned.  Block
+      Lanczos with blockSize vectors resolves eigenvalues repeated up
+      to blockSize times (six rigid modes, the five-fold modes of
+      icosahedral shells).  On return modes (if not null) holds the
+      mass-orthonormal mode shapes, _dof values each, one after the
+      other.  Returns the number of converged modes.
+    */
+    int normalModesLanczos(int nmodes, std::vector<double> & eigenvalues,
+			   std::vector<double> * modes,
+			   const std::vector<double> * weight=0, double dens=1.0,
+			   bool deflateRigid=true, bool assembled=false,
+			   double tol=1.0e-8, int blockSize=6);
+
+    //! Mass-weighted, orthonormalized rigid-body modes M^1/2 u_rigid
+    void rigidBodyModes(const blitz::Array<double,1> & mass,
+			std::vector<double> & modes) const;
+
     void normalModes_all(bool eigenvectors, int nmodes, std::vector<double> &weight, double dens, std::string filename);
     void normalModes_all(bool eigenvectors, int nmodes, std::string filename);
     
@@ -116,13 +185,16 @@ namespace voom
 //       for(ConstBodyIterator b=_bodies.begin(); b!=_bodies.end(); b++)
 // 	(*b)->print(name);
       char str[10];
+      const bool profiling = Profiler::enabled();
       if(_bodies.size() == 1) {
+	Profiler::Scope scope( profiling ? _profileRegion(_bodies[0], 0, "print") : -1 );
 	_bodies[0]->print(name);
       } else {
 	for(int i=0; i<_bodies.size(); i++) {
 	  std::string bdname = name;
 	  sprintf(str,"-bd%d",i);
 	  bdname += str;
+	  Profiler::Scope scope( profiling ? _profileRegion(_bodies[i], i, "print") : -1 );
 	  _bodies[i]->print(bdname);
 	}
       }
@@ -138,6 +210,11 @@ namespace voom
 
   private:
 
+    //! Not copyable: bound nodes view this model's _field/_force, so
+    //! a copy would leave them pointing into another model's buffer
+    Model( const Model & );
+    Model & operator=( const Model & );
+
     //! total degree of freedom in the Model
     int _dof;
 
@@ -155,6 +232,34 @@ namespace voom
 
     ConstraintContainer _constraints;
 
+    //! Contiguous field and force storage, see bindStorage()
+    bool _bound;
+    std::vector<double> _field;
+    std::vector<double> _force;
+
+    //! Global dof of every element dof (-1 if its node is not a
+    //! model node), element after element, set by buildSparsity
+    std::vector<int> _elementDof;
+
+    //! Connectivity generation and element count of each body when
+    //! the sparsity pattern was built
+    std::vector<unsigned long> _sparsityConnectivity;
+
+    //! Lumped mass for normal mode analysis
+    void _lumpedMass(const std::vector<double> * weight, double dens,
+		     blitz::Array<double,1> & mass) const;
+
+    //! Print normal mode shapes and frequencies
+    void _printModes(bool eigenvectors, const std::vector<double> & eigenvalues,
+		     const std::vector<double> & modes, std::string filename);
+
+    //! Profiler region "<type> <i> <stage>" of a body or constraint
+    template<class T>
+    int _profileRegion(const T * object, int i, const char * stage) const;
+
+    //! True if some body changed connectivity since buildSparsity
+    bool _sparsityChanged() const;
+
 #ifdef WITH_MPI
     int _nProcessors;
     int _processorRank;
@@ -73,9 +73,9 @@ namespace voom
     //! add force
     void addForce(double df) {
 #ifdef _OPENMP
-#pragma omp critical
+#pragma omp atomic
 #endif
-      _force = _force + df;
+      _force += df;
     }
 
     virtual void setPosition(int i, double x) {assert(i<dim_n); _X(i) = x; }
@@ -92,9 +92,9 @@ namespace voom
     virtual void addPoint(int i, double dx) {
       assert(i==0); 
 #ifdef _OPENMP
-#pragma omp critical
+#pragma omp atomic
 #endif
-      _point = _point + dx;
+      _point += dx;
     }
     
     virtual double getForce(int i) const { assert(i==0); return _force; }
@@ -104,9 +104,9 @@ namespace voom
     virtual void addForce(int i, double df) {
       assert(i==0); 
 #ifdef _OPENMP
-#pragma omp critical
+#pragma omp atomic
 #endif
-      _force = _force + df;
+      _force += df;
     }
 
     virtual void setPosition( const PositionVector & p ) { _X = p; }
@@ -114,9 +114,9 @@ namespace voom
     //! update force by some increment
     virtual void updateForce( const Point & f ) { 
 #ifdef _OPENMP
-#pragma omp critical
+#pragma omp atomic
 #endif
-      _force = _force + f;
+      _force += f;
     }
 
     void resetPosition() {_X = _point;}
@@ -146,16 +146,32 @@ namespace voom
     typedef typename tvmet::Vector<double,dim_n> PositionVector;
 
     //! default constructor
-    DeformationNode() {}
+    DeformationNode() : _point(&_ownPoint), _force(&_ownForce) {}
 
     //! construct from position and point
     DeformationNode(int id, const NodeBase::DofIndexMap & index, 
-		    const Point & X, const Point & p) : Base(id,index)
-    { _X = X; _point = p; }
+		    const Point & X, const Point & p) 
+      : Base(id,index), _point(&_ownPoint), _force(&_ownForce)
+    { _X = X; *_point = p; }
 
     DeformationNode(int id, const NodeBase::DofIndexMap & index, 
-		    const Point & X) : Base(id,index) 
-    { _X = _point = X; }
+		    const Point & X) 
+      : Base(id,index), _point(&_ownPoint), _force(&_ownForce)
+    { _X = *_point = X; }
+
+    //! copies own their point and force, even if n is bound
+    DeformationNode(const DeformationNode & n) 
+      : Base(n), _point(&_ownPoint), _force(&_ownForce),
+	_ownPoint(*n._point), _ownForce(*n._force), _X(n._X), _stiff(n._stiff) {}
+
+    DeformationNode & operator=(const DeformationNode & n) {
+      if(this != &n) {
+	Base::operator=(n);
+	*_point = *n._point; *_force = *n._force;
+	_X = n._X; _stiff = n._stiff;
+      }
+      return *this;
+    }
 
     //! access reference position
     const PositionVector & position() {return _X;}
@@ -163,56 +179,75 @@ namespace voom
     void setPosition( const PositionVector & p ) { _X = p; }
 
     //! access point
-    const Point & point() const {return _point;}
+    const Point & point() const {return *_point;}
 
     //! access force
-    const Point & force() const {return _force;}
+    const Point & force() const {return *_force;}
  
     virtual void setPosition(int i, double x) {assert(i<dim_n); _X(i) = x; }
 
     virtual double getPosition(int i) const { assert(i<dim_n); return _X(i); }
 
     // it seems like this should be inherited from Node, but GCC objects...?
-    virtual void setPoint( const Point & p ) { _point = p; }
+    virtual void setPoint( const Point & p ) { *_point = p; }
 
-    virtual double getPoint(int i) const { assert(i<dim_n); return _point(i); }
+    virtual double getPoint(int i) const { assert(i<dim_n); return (*_point)(i); }
 
-    virtual void setPoint(int i, double x) {assert(i<dim_n); _point(i) = x; }
+    virtual void setPoint(int i, double x) {assert(i<dim_n); (*_point)(i) = x; }
    
     virtual void addPoint(int i, double dx) {
       assert(i<dim_n); 
 #ifdef _OPENMP
-#pragma omp critical
+#pragma omp atomic
 #endif
-      _point(i) = _point(i) + dx;//+= dx; 
+      (*_point)(i) += dx;
     }
     
-    virtual double getForce(int i) const { assert(i<dim_n); return _force(i); }
+    virtual double getForce(int i) const { assert(i<dim_n); return (*_force)(i); }
 
-    virtual void setForce(int i, double f) {assert(i<dim_n); _force(i) = f; }
+    virtual void setForce(int i, double f) {assert(i<dim_n); (*_force)(i) = f; }
 
     virtual void addForce(int i, double df) {
       assert(i<dim_n); 
 #ifdef _OPENMP
-#pragma omp critical
+#pragma omp atomic
 #endif
-      _force(i) = _force(i) + df;// += df; 
+      (*_force)(i) += df;
     }
 
     //! update force by some increment
     virtual void updateForce( const Point & f ) { 
       for(int i=0; i<dim_n; i++) {
 #ifdef _OPENMP
-#pragma omp critical
+#pragma omp atomic
 #endif
-	_force(i) = _force(i) + f(i);
+	(*_force)(i) += f(i);
       }
     }
 
-    void resetPosition() {_X = _point;}
+    void resetPosition() {_X = *_point;}
 
     virtual int dof() const {return dim_n;}
 
+    //! Point and force become views of x and f at index()
+    /*! Requires contiguous dof indices and a tvmet::Vector laid out
+      as dim_n doubles (no TVMET_DYNAMIC_MEMORY). */
+    virtual bool bindStorage(double * x, double * f) {
+      if( sizeof(Point) != dim_n*sizeof(double) ) return false;
+      if( _index.size() != dim_n ) return false;
+      for(int i=1; i<dim_n; i++) 
+	if( _index[i] != _index[0]+i ) return false;
+      Point * p = reinterpret_cast<Point*>(x + _index[0]);
+      Point * g = reinterpret_cast<Point*>(f + _index[0]);
+      *p = *_point; *g = *_force;
+      _point = p; _force = g;
+      return true;
+    }
+
+    virtual void unbindStorage() {
+      _ownPoint = *_point; _ownForce = *_force;
+      _point = &_ownPoint; _force = &_ownForce;
+    }
 
     virtual double getStiffness(int i) const { 
       assert(i<dim_n); return _stiff(i); 
@@ -225,25 +260,28 @@ namespace voom
     virtual void addStiffness(int i, double dk) {
       assert(i<dim_n); 
 #ifdef _OPENMP
-#pragma omp critical
+#pragma omp atomic
 #endif
-      _stiff(i) = _stiff(i) + dk;// += df; 
+      _stiff(i) += dk;
     }
 
     //! update stiffness by some increment
     virtual void updateStiffness( const Point & k ) { 
       for(int i=0; i<dim_n; i++) {
 #ifdef _OPENMP
-#pragma omp critical
+#pragma omp atomic
 #endif
-	_stiff(i) = _stiff(i) + k(i);
+	_stiff(i) += k(i);
       }
     }
 
 
   protected:
-    Point _point;
-    Point _force;
+    //! point and force; own storage unless bound to model storage
+    Point * _point;
+    Point * _force;
+    Point _ownPoint;
+    Point _ownForce;
     PositionVector _X;
 
     Point _stiff;
@@ -310,40 +348,46 @@ namespace voom
     //! One dof (projection of point onto normal)
     int dof() const {return 1;}
 
+    //! The single dof is a projection, not stored, so never bound
+    bool bindStorage(double * x, double * f) { return false; }
+
     virtual double getPoint(int i) const { 
       assert(i==0); 
-      return dot(_point,_n); 
+      return dot(*_point,_n); 
     }
 
     virtual void setPoint(int i, double x) {
       assert(i==0); 
-      _point = _point - _n*dot(_point,_n) + x*_n; 
+      Point & p = *_point;
+      p = p - _n*dot(p,_n) + x*_n; 
     }
    
     virtual void addPoint(int i, double dx) {
       assert(i==0); 
+      for(int j=0; j<dim_n; j++) {
 #ifdef _OPENMP
-#pragma omp critical
+#pragma omp atomic
 #endif
-      _point = _point + _n*dx;
+	(*_point)(j) += _n(j)*dx;
+      }
     }
     
     virtual double getForce(int i) const { 
       assert(i==0); 
-      return dot(_force,_n); 
+      return dot(*_force,_n); 
     }
 
     virtual void setForce(int i, double f) {
       assert(i<dim_n); 
-      _force(i) = f; 
+      (*_force)(i) = f; 
     }
 
     virtual void addForce(int i, double df) {
       assert(i<dim_n); 
 #ifdef _OPENMP
-#pragma omp critical
+#pragma omp atomic
 #endif
-      _force(i) = _force(i) + df;// += df; 
+      (*_force)(i) += df;
     }
     
   protected:
@@ -498,6 +542,11 @@ namespace voom
     void addDrag( int i, int j, double d )
     { assert(i<dim_n && j<dim_n); _D(i,j) += d; }
 
+    //! addForce without the atomic update, for callers that make sure
+    //! no other thread writes to the node meanwhile
+    void addForceExclusive(int i, double df)
+    { assert(i<dim_n); (*this->_force)(i) += df; }
+
   protected:
     Point _v;
     Matrix _M;
@@ -531,18 +580,18 @@ namespace voom
     void addPoint(int i, double dx) {
       assert(i==0); 
 #ifdef _OPENMP
-#pragma omp critical
+#pragma omp atomic
 #endif
-      _point = _point + dx;//+= dx;
+      _point += dx;
     }    
     double getForce(int i) const {assert(i==0); return _force;}
     void setForce(int i, double f) {assert(i==0); _force = f;}
     void addForce(int i, double df) {
       assert(i==0); 
 #ifdef _OPENMP
-#pragma omp critical
+#pragma omp atomic
 #endif
-      _force = _force + df;// += df;
+      _force += df;
     }    
 
     // it seems like this should be inherited from Node, but GCC objects...?
@@ -582,9 +631,9 @@ namespace voom
     void addPoint(int i, double dx) {
       assert(i<dim_n); 
 #ifdef _OPENMP
-#pragma omp critical
+#pragma omp atomic
 #endif
-      _point(i) = _point(i) + dx;//+= dx; 
+      _point(i) += dx;
     }
 
     double getForce(int i) const { assert(i<dim_n); return _force(i); }
@@ -594,9 +643,9 @@ namespace voom
     void addForce(int i, double df) {
       assert(i<dim_n); 
 #ifdef _OPENMP
-#pragma omp critical
+#pragma omp atomic
 #endif
-      _force(i) = _force(i) + df;// += df; 
+      _force(i) += df;
     }
 
     int dof() const {return dim_n;}
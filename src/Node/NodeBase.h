@@ -68,6 +68,18 @@ namespace voom
     virtual void setStiffness(int ia, double k) {};
     virtual void addStiffness(int ia, double k) {};    
 
+    //! Keep point and force in external contiguous storage
+    /*! On success the node's dof values live at x[index()[i]] and its
+      forces at f[index()[i]] (current values are copied there first),
+      so a solver working on x sees the node without any copying.
+      Nodes that cannot be views return false and keep their own
+      storage.
+    */
+    virtual bool bindStorage(double * x, double * f) { return false; }
+
+    //! Return to node-owned storage, keeping the current values
+    virtual void unbindStorage() {}
+
     virtual double getMass() const {return 0;}
 
     virtual void setMass(double m) {};
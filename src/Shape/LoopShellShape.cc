@@ -13,12 +13,91 @@
 //
 //----------------------------------------------------------------------
 
+#include <map>
 #include "LoopShellShape.h"
 
 //#define DEBUG_SUB
 
 namespace voom
 {
+  namespace {
+    //! key of the shared shape cache
+    struct LoopShellShapeKey {
+      int nodes;
+      unsigned v[3];
+      double s[2];
+
+      bool operator<(const LoopShellShapeKey & k) const {
+	if(nodes != k.nodes) return nodes < k.nodes;
+	for(int i=0; i<3; i++) if(v[i] != k.v[i]) return v[i] < k.v[i];
+	for(int i=0; i<2; i++) if(s[i] != k.s[i]) return s[i] < k.s[i];
+	return false;
+      }
+    };
+
+    typedef std::map<LoopShellShapeKey, LoopShellShape*> LoopShellShapeCache;
+
+    LoopShellShapeCache & loopShellShapeCache() {
+      static LoopShellShapeCache cache;
+      return cache;
+    }
+  }
+
+  const LoopShellShape & LoopShellShape::shared(const int nodes,
+						const CornerValences & V,
+						const CoordinateArray & paraCoords)
+  {
+    LoopShellShapeKey key;
+    key.nodes = nodes;
+    for(int i=0; i<3; i++) key.v[i] = V(i);
+    for(int i=0; i<2; i++) key.s[i] = paraCoords(i);
+
+    LoopShellShape * shape = 0;
+#ifdef _OPENMP
+#pragma omp critical(LoopShellShapeCache)
+#endif
+    {
+      LoopShellShapeCache & cache = loopShellShapeCache();
+      LoopShellShapeCache::iterator it = cache.find(key);
+      if( it == cache.end() ) {
+	shape = new LoopShellShape(nodes, V, paraCoords);
+	shape->_makeFlat();
+	cache.insert( std::make_pair(key, shape) );
+      } else {
+	shape = it->second;
+      }
+    }
+    return *shape;
+  }
+
+  int LoopShellShape::sharedTables() {
+    int n = 0;
+#ifdef _OPENMP
+#pragma omp critical(LoopShellShapeCache)
+#endif
+    n = loopShellShapeCache().size();
+    return n;
+  }
+
+  void LoopShellShape::_makeFlat()
+  {
+    // N, DN and DDN back to back; never freed, as the cache is global
+    double * block = new double[7*_nodes];
+
+    FunctionArray N(block, blitz::shape(_nodes), blitz::neverDeleteData);
+    DerivativeArray DN(block + _nodes, blitz::shape(_nodes,2),
+		       blitz::neverDeleteData);
+    SecondDerivativeArray DDN(block + 3*_nodes, blitz::shape(_nodes,2,2),
+			      blitz::neverDeleteData);
+    N = _functions;
+    DN = _derivatives;
+    DDN = _secondDerivatives;
+
+    _functions.reference(N);
+    _derivatives.reference(DN);
+    _secondDerivatives.reference(DDN);
+  }
+
   //! constructor function with parrametric coords
   void LoopShellShape::_initialize(const int nodes,
 				  const CornerValences & V,
@@ -124,6 +124,9 @@ namespace voom
     //!
     void _initialize(const int nodes, const CornerValences & V, 
 		    const CoordinateArray & paraCoords);
+    //! move the tables into one flat block owned by the shared cache
+    void _makeFlat();
+
     void _initialize(const int nodes, const CornerValences & V) {
       CoordinateArray paraCoords;
       paraCoords = 1.0/3.0, 1.0/3.0;
@@ -147,6 +150,22 @@ namespace voom
       return _secondDerivatives;
     }
 
+    //! Shape at paraCoords shared by all patches with valences V
+    /*! Tables are computed once per (valences, parametric point),
+      i.e. once per valence pattern and quadrature rule rather than
+      once per element, and are kept for the life of the program.
+      Functions and derivatives of an entry live in one flat block
+      and copies of the returned shape (e.g. in quadrature point
+      structs) are read-only views into it.  Safe to call from
+      several threads.
+    */
+    static const LoopShellShape & shared(const int nodes,
+					 const CornerValences & V,
+					 const CoordinateArray & paraCoords);
+
+    //! Number of distinct tables in the shared cache
+    static int sharedTables();
+
     //! verify the correction of the shape functions
     static void checkShapeFunctions();
 
@@ -0,0 +1,46 @@
+#include "../LoopShellShape.h"
+#include <iostream>
+#include <cmath>
+
+using namespace std;
+using namespace voom;
+
+int main()
+{
+  cout << "Test shared LoopShellShape tables" << endl;
+
+  bool passed = true;
+  LoopShellShape::CoordinateArray s;
+  s = 1.0/6.0, 2.0/3.0;
+
+  unsigned valences[2][3] = { {6,6,6}, {5,6,6} };
+  for(int c = 0; c < 2; c++) {
+    LoopShellShape::CornerValences V(valences[c][0], valences[c][1], valences[c][2]);
+    const int n = V(0) + V(1) + V(2) - 6;
+
+    LoopShellShape fresh(n, V, s);
+    const LoopShellShape & shared = LoopShellShape::shared(n, V, s);
+    const LoopShellShape & again  = LoopShellShape::shared(n, V, s);
+
+    // a copy, as stored in quadrature points, must see the same values
+    LoopShellShape copy(shared);
+
+    double error = 0.0;
+    for(int a = 0; a < n; a++) {
+      error += fabs(fresh.functions()(a) - copy.functions()(a));
+      for(int i = 0; i < 2; i++) {
+	error += fabs(fresh.derivatives()(a,i) - copy.derivatives()(a,i));
+	for(int j = 0; j < 2; j++)
+	  error += fabs(fresh.secondDerivatives()(a,i,j) - copy.secondDerivatives()(a,i,j));
+      }
+    }
+    cout << "Valences " << V << ": error = " << error << endl;
+    if(error > 1.0e-14 || &shared != &again) passed = false;
+  }
+  if(LoopShellShape::sharedTables() != 2) passed = false;
+
+  if(passed) cout << "Shared LoopShellShape test PASSED!" << endl;
+  else cout << "Shared LoopShellShape test FAILED!" << endl;
+
+  return 0;
+}
@@ -19,58 +19,21 @@ namespace voom {
     // main loop
     //
     double t=0;
+    _update.zero();
     for(int step=0; step < nSteps; step++ ) {
     
       // compute only Brownian forces at initial positions
-      computeAndAssemble( false, false, true );
+      _compute( false, false, true );
       
-      // do a half time-step
-      for( NodeIterator n=_nodes.begin(); n!=_nodes.end(); n++ ) {	
-
-	// get force and drag
-	const Node_t::Point & f = (*n)->force();
-	const Node_t::Matrix & D = (*n)->drag();
-
-	// mobility = inverse of drag
-	Node_t::Matrix M(0.0);
-	invert(D,M);
-	
-	// compute displacement
-	Node_t::Point dx;
-	dx = -0.5*dt*M*f;
-	
-	// save initial position as reference
-	(*n)->resetPosition();
-
-	// add displacement to node
-	for(int i=0; i<(*n)->dof(); i++) (*n)->addPoint(i,dx(i));
-	
-      }
+      // do a half time-step from the saved initial positions
+      _update.displace( -0.5*dt, BrownianUpdate<Node_t>::SAVE, true );
 
       // Compute deterministic forces at new half-step positions, but
       // don't update Brownian forces
-      computeAndAssemble( true, true, false );
+      _compute( true, true, false );
 
       // Compute velocities and do a full time-step from the initial positions
-      for( NodeIterator n=_nodes.begin(); n!=_nodes.end(); n++ ) {	
-	
-	// get force and drag
-	const Node_t::Point & f = (*n)->force();
-	const Node_t::Matrix & D = (*n)->drag();
-
-	// mobility = inverse of drag
-        Node_t::Matrix M(0.0);
-	invert(D,M);
-	
-	// compute displacement
-	Node_t::Point dx;
-	dx = -dt*M*f;
-	
-	// displace from initial position
-	(*n)->setPoint( (*n)->position() );
-	for(int i=0; i<(*n)->dof(); i++) (*n)->addPoint(i,dx(i));
-	
-      }
+      _update.displace( -dt, BrownianUpdate<Node_t>::POSITION, true );
      
       t += dt;
 
@@ -88,6 +51,7 @@ namespace voom {
 	  _bodies[i]->print(s);	  
 	}
 	std::cout << "Printed bodies." << std::endl;
+	_update.zero();
       }
       
     }
@@ -111,14 +75,12 @@ namespace voom {
     }
 
     // zero out all forces and stiffness in nodes before computing bodies
-    for(NodeIterator n=_nodes.begin(); n!=_nodes.end(); n++) {
-
-      for(int i=0; i<(*n)->dof(); i++) (*n)->setForce(i,0.0);
-
-      (*n)->setMobility( Node_t::Matrix(0.0) );
-      (*n)->setDrag( Node_t::Matrix(0.0) );
-    }
+    _update.zero();
+    _compute( f0, f1, f2 );
+  }
 
+  void BrownianDynamics::_compute(bool f0, bool f1, bool f2)
+  {
     // Predictor/corrector approach for constraint
     for(ConstraintIterator c=_constraints.begin(); c!=_constraints.end(); c++) {
       (*c)->predict();
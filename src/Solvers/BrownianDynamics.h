@@ -19,12 +19,15 @@
 #include<random/normal.h>
 #include<vector>
 #include "Solver.h"
+#include "BrownianUpdate.h"
 
 namespace voom
 {
 
   /*!  A concrete class for a Brownian dynamics solver for a Finite
-       Element model.
+       Element model.  Each step is a midpoint predictor/corrector;
+       the node updates run in parallel (BrownianUpdate), and with
+       setConstantDrag(true) the nodal mobilities are computed once.
   */
 
   class BrownianDynamics
@@ -52,7 +55,7 @@ namespace voom
     BrownianDynamics(NodeContainer & n,
 		     int printStride,
 		     bool debug=false) 
-      :  _nodes(n), _printStride(printStride), _debug(debug) 
+      :  _nodes(n), _printStride(printStride), _debug(debug), _update(_nodes) 
     { 
       int dof = 0;
       for(ConstNodeIterator n=_nodes.begin(); n!=_nodes.end(); n++) 
@@ -72,6 +75,9 @@ namespace voom
     //! overloading pure virtual function solve()
     int run(int nSteps, double dt);
 
+    //! Drag independent of the configuration: invert it only once
+    void setConstantDrag(bool constant) { _update.setConstantDrag(constant); }
+
     void pushBackConstraint( Constraint * c ) { _constraints.push_back( c ); }
 
     void pushBackBody( Body * bd ) { _bodies.push_back( bd ); }
@@ -98,6 +104,11 @@ namespace voom
     //! container of the nodes that represent all of the dof in the model
     NodeContainer _nodes;
 
+    BrownianUpdate<Node_t> _update;
+
+    //! computeAndAssemble on nodes that are already zeroed
+    void _compute( bool f0, bool f1, bool f2 );
+
   };
   
 }; // namespace voom
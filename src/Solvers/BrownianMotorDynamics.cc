@@ -17,14 +17,8 @@ namespace voom {
     //
     // main loop
     //
+    _update.zero();
     for(int step=0; step < nSteps; step++ ) {
-      for( NodeIterator n=_nodes.begin(); n!=_nodes.end(); n++ ) {
-      // zero out all forces and stiffness in nodes //
-	
-	for(int i=0; i<(*n)->dof(); i++) (*n)->setForce(i,0.0);
-	(*n)->setMobility( Node_t::Matrix(0.0) );
-	(*n)->setDrag( Node_t::Matrix(0.0) );
-      }
       if ( _printStride > 0 && step % _printStride == 0) {
 	// comptue energy and force and print stuff out
 	computeAndAssemble( true, true, false );
@@ -45,27 +39,8 @@ namespace voom {
 	computeAndAssemble( false, true, false );
       }
       
-    // get force and mobility
-      for( NodeIterator n=_nodes.begin(); n!=_nodes.end(); n++ ) {
-	const Node_t::Point & f = (*n)->force();
-	const Node_t::Matrix & D = (*n)->drag();
-	
-	Tensor2D M(0.0);
-	double det;
-	det = D(0,0)*D(1,1)-D(0,1)*D(1,0);
-	M(0,0) = D(1,1)/det;
-	M(0,1) = -D(0,1)/det; 
-	M(1,0) = -D(1,0)/det; 
-	M(1,1) = D(0,0)/det; 
-     
-	// compute displacement
-	Node_t::Point dx;
-	dx = -dt*M*f;//*****Added a minus sign*****
-
-	// add displacement to node
-	for(int i=0; i<(*n)->dof(); i++) (*n)->addPoint(i,dx(i));
-
-      }
+      // displace nodes and zero them for the next step
+      _update.displace( -dt, BrownianUpdate<Node_t>::CURRENT, true );
 
       for( MotorIterator m=_motors.begin(); m!=_motors.end(); m++) {
 	if((*m)->isAttached()) (*m)->stepMotor();
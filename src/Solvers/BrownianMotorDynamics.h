@@ -20,6 +20,7 @@
 #include<vector>
 #include "Solver.h"
 #include "Motor.h"
+#include "BrownianUpdate.h"
 
 namespace voom
 {
@@ -56,7 +57,7 @@ namespace voom
     
 
     BrownianMotorDynamics(NodeContainer & n, MotorContainer & m, int printStride, bool debug=false) 
-      :  _nodes(n), _motors(m), _printStride(printStride), _debug(debug) 
+      :  _nodes(n), _motors(m), _printStride(printStride), _debug(debug), _update(_nodes) 
     { 
       int dof = 0;
       for(ConstNodeIterator n=_nodes.begin(); n!=_nodes.end(); n++) 
@@ -78,6 +79,9 @@ namespace voom
 
     int doMotorHalfStep(double dt);
 
+    //! Drag independent of the configuration: invert it only once
+    void setConstantDrag(bool constant) { _update.setConstantDrag(constant); }
+
     void pushBackConstraint( Constraint * c ) { _constraints.push_back( c ); }
 
     void pushBackBody( Body * bd ) { _bodies.push_back( bd ); }
@@ -106,6 +110,8 @@ namespace voom
 
     MotorContainer _motors;
 
+    BrownianUpdate<Node_t> _update;
+
   };
   
 }; // namespace voom
@@ -0,0 +1,116 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+
+/*!
+  \file BrownianUpdate.h
+
+  \brief Parallel node updates shared by the Brownian dynamics
+  integrators.
+
+*/
+
+#if !defined(__BrownianUpdate_h__)
+#define __BrownianUpdate_h__
+
+#include<vector>
+#include "VoomMath.h"
+
+namespace voom
+{
+
+  /*!  The node passes of a Brownian dynamics step: dx = scale*M*f
+    with the mobility M = D^{-1} of the nodal drag, applied from the
+    current point or from the saved position, fused with zeroing the
+    nodal force and drag for the next computeAndAssemble, in one
+    OpenMP parallel loop over the nodes.  Every iteration touches only
+    its own node, so no atomics are needed.
+
+    If the drag does not depend on the configuration (fixed bead
+    drag, or rods whose drag is frozen), setConstantDrag(true) makes
+    the mobilities be inverted once, on the first pass, and reused
+    for the rest of the run.  Node_t is a BrownianNode<2> or <3>.
+  */
+  template< class Node_t >
+  class BrownianUpdate
+  {
+  public:
+
+    typedef typename Node_t::Matrix Matrix;
+    typedef typename Node_t::Point Point;
+
+    //! Where a displacement starts
+    enum Start {
+      CURRENT,   //!< x += dx
+      SAVE,      //!< save x as position, then x += dx
+      POSITION   //!< x = position + dx
+    };
+
+    BrownianUpdate(std::vector<Node_t*> & nodes)
+      : _nodes(nodes), _constantDrag(false), _cached(false) {}
+
+    void setConstantDrag(bool constant) {
+      _constantDrag = constant;
+      _cached = false;
+    }
+
+    //! Zero nodal forces, drag and mobility
+    void zero() {
+      const int N = _nodes.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+      for(int a=0; a<N; a++) _zero(_nodes[a]);
+    }
+
+    //! Displace every node by scale*M*f; optionally zero afterwards
+    void displace(double scale, Start start, bool zeroAfter) {
+      const int N = _nodes.size();
+      // nodes added or removed since caching: rebuild the cache
+      if( N != _mobility.size() ) _cached = false;
+      const bool useCache = _constantDrag && _cached;
+      if( _constantDrag && !_cached ) _mobility.resize(N);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+      for(int a=0; a<N; a++) {
+	Node_t * n = _nodes[a];
+	Matrix M(0.0);
+	if( useCache ) M = _mobility[a];
+	else {
+	  invert(n->drag(), M);
+	  if( _constantDrag ) _mobility[a] = M;
+	}
+	Point dx;
+	dx = scale*M*n->force();
+	if( start == SAVE ) n->resetPosition();
+	if( start == POSITION ) n->setPoint( n->position() );
+	for(int i=0; i<n->dof(); i++) n->addPoint(i,dx(i));
+	if( zeroAfter ) _zero(n);
+      }
+      if( _constantDrag ) _cached = true;
+    }
+
+  private:
+
+    std::vector<Node_t*> & _nodes;
+
+    bool _constantDrag;
+    bool _cached;
+    std::vector<Matrix> _mobility;
+
+    static void _zero(Node_t * n) {
+      for(int i=0; i<n->dof(); i++) n->setForce(i,0.0);
+      n->setMobility( Matrix(0.0) );
+      n->setDrag( Matrix(0.0) );
+    }
+  };
+
+}; // namespace voom
+
+#endif // __BrownianUpdate_h__
@@ -79,7 +79,10 @@ namespace voom
   int CGfast::solve(Model * m) {
 
     _model = m;
-    if( _size != _model->dof() ) resize( _model->dof() );
+    if( _size != _model->dof() || (_shared && !_model->storageBound()) ) 
+      resize( _model->dof() );
+
+    if( shareModelStorage(_model, _x, _g) ) _shared = true;
     const blitz::TinyVector< int, 1 > shp = _x.shape();
     Vector_t gradOld(shp); 
     Vector_t searchDir(shp); 
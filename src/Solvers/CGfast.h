@@ -67,7 +67,7 @@ namespace voom
     };
     
     //! Default Constructor
-    CGfast(bool debug=false) {
+    CGfast(bool debug=false) : _size(0), _shared(false) {
       _debug = debug;
       setParameters();
     }
@@ -126,6 +126,9 @@ namespace voom
     
     const blitz::Array<double,1> & gradient() const {return _g;}
     const blitz::Array<double,2> & hessian() const;
+
+    const double * fieldData() const {return _x.data();}
+    const double * gradientData() const {return _g.data();}
     
     void zeroOutData(bool f0, bool f1, bool f2) {
       if(f0) _f=0.0;
@@ -138,6 +141,7 @@ namespace voom
       _g.resize(sz); 
       _h.resize(sz); 
       _size = sz;
+      _shared = false;
       _f = 0.0;
       _x = 0.0;
       _g = 0.0;
@@ -164,6 +168,9 @@ namespace voom
     
     size_t _size;
 
+    //! true if _x and _g are views of the model's bound storage
+    bool _shared;
+
     Model * _model;
 
     //  using PR or FR algorithm
@@ -21,21 +21,21 @@ extern "C" int cg_descent /*  return  0 (convergence tolerance satisfied)
     double            *x , /* input: starting guess, output: the solution */
     int              dim , /* problem dimension (also denoted n) */
     double    (*cg_value)  /* user provided routine to return the function */
-               (double *), /* value at x */
+       (double *, void *), /* value at x */
     void       (*cg_grad)  /* user provided routine, returns in g the */
-      (double *, double*), /* gradient at x*/
+      (double *, double*, void *), /* gradient at x*/
     double         *work , /* working array with at least 4n elements */
     double          step , /* initial step for line search
                               ignored unless Step != 0 in cg.parm */
-    cg_stats      *Stats   /* structure with statistics(see cg_descent.h) */
+    cg_stats      *Stats , /* structure with statistics(see cg_descent.h) */
+    void           *User   /* context passed to cg_value and cg_grad */
 ) ;
 
 
 namespace voom {
 
   int CgDescent::solve(Model * model) {
-    ::cgModel = model;
-    ::cgSolver = this;
+    _model = model;
 
     // resize arrays if necessary
     if(  _x.size() != model->dof() ) {
@@ -58,8 +58,8 @@ namespace voom {
 
     std::cout << "calling cg_descent" << std::endl;
     status = cg_descent( _tol, xtemp.data(), n, 
-			 ::myvalue, ::mygrad, 
-			 _work.data(), step, &Stats);
+			 &CgDescent::_value, &CgDescent::_gradient, 
+			 _work.data(), step, &Stats, this);
     std::cout << "finished cg_descent" << std::endl;
 
     _x = xtemp;
@@ -69,19 +69,32 @@ namespace voom {
     return 0;
   }
 
+  void CgDescent::_compute(const double * x, bool f0, bool f1) {
+    const int n = _x.size();
+    double * field = _x.data();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(int i=0; i<n; i++) field[i] = x[i];
+    _model->putField( *this );
+    _model->computeAndAssemble( *this, f0, f1, false );
+  }
 
-} // end namespace
+  double CgDescent::_value(double * x, void * context) {
+    CgDescent * solver = static_cast<CgDescent*>(context);
+    solver->_compute(x, true, false);
+    return solver->_f;
+  }
 
-double myvalue( double *x ) {
-  for(int i=0; i < (::cgSolver)->size(); i++) (::cgSolver)->field(i) = x[i];
-  ::cgModel->putField( *::cgSolver );
-  ::cgModel->computeAndAssemble( *::cgSolver, true, false, false );
-  return ::cgSolver->function();
-}
-
-void mygrad(double *g, double *x) {
-  for(int i=0; i < (::cgSolver)->size(); i++) (::cgSolver)->field(i) = x[i];
-  ::cgModel->putField( *::cgSolver );
-  ::cgModel->computeAndAssemble( *::cgSolver, false, true, false );
-  for(int i=0; i < (::cgSolver)->size(); i++) g[i] = (::cgSolver)->gradient(i);
-}
+  void CgDescent::_gradient(double * g, double * x, void * context) {
+    CgDescent * solver = static_cast<CgDescent*>(context);
+    solver->_compute(x, false, true);
+    const int n = solver->_g.size();
+    const double * grad = solver->_g.data();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(int i=0; i<n; i++) g[i] = grad[i];
+  }
+
+} // end namespace
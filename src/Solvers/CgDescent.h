@@ -24,7 +24,7 @@
 /////////////////////////////////////////////////////////////////////////
 
 /*! 
-  \file Lbfgsb.h
+  \file CgDescent.h
 
   \brief Interface to a concrete class for Conjugate Gradient solver for static
   equilibrium of a (nonlinear) Finite Element model.
@@ -49,6 +49,11 @@ namespace voom
 
   /*!  A concrete class for nonlinear conjugate gradient solver for
     static equilibrium of a Finite Element model.
+
+    The C routine cg_descent reaches the model through a context
+    pointer passed to its callbacks, so several CgDescent solvers (on
+    different models) may run concurrently, e.g. one per OpenMP
+    thread.  Each call still reads cg_descent_c.parm.
   */
 
   class CgDescent : public Solver
@@ -59,7 +64,7 @@ namespace voom
     typedef blitz::Array<double,1> Vector_t;
     
     //! Default Constructor
-    CgDescent(int n, double tol) : _tol(tol) { 
+    CgDescent(int n, double tol) : _tol(tol), _model(0) { 
       resize(n);
     }
     //! destructor
@@ -90,6 +95,9 @@ namespace voom
     double * field() {return _x.data();}
     double * gradient() {return _g.data();}
 
+    const double * fieldData() const {return _x.data();}
+    const double * gradientData() const {return _g.data();}
+
     void zeroOutData(bool f0, bool f1, bool f2) {
       if(f0) _f=0.0;
       if(f1) _g=0.0;
@@ -120,18 +128,18 @@ namespace voom
 
     double _tol;
 
-  };
-  
-}; // namespace voom
+    Model * _model;
 
-// Global model pointer needed to wrap C++ member functions for C code.
-extern voom::Model * cgModel;
-extern voom::CgDescent * cgSolver;
+    //! Callbacks for cg_descent; context is the CgDescent
+    static double _value(double * x, void * context);
+    static void _gradient(double * g, double * x, void * context);
 
-extern double myvalue( double *x );
-
-extern void mygrad(double *g, double *x);
+    //! Copy x into the field and compute
+    void _compute(const double * x, bool f0, bool f1);
 
+  };
+  
+}; // namespace voom
 
 // The file cg_descent_c.parm must be present in the directory from
 // which the code is executed.  It should have the following format.
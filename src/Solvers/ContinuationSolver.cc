@@ -0,0 +1,285 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+
+#include<iostream>
+#include<cmath>
+#include<algorithm>
+
+#include "ContinuationSolver.h"
+
+using std::cout;
+using std::endl;
+using std::setw;
+using std::right;
+using std::scientific;
+
+namespace voom
+{
+
+  ContinuationSolver::ContinuationSolver(Parameter * parameter, int m, double gtol,
+					 int maxIterations, Predictor predictor)
+    : _parameter(parameter), _model(0), _n(0), _f(0.0), _shared(false),
+      _memory(0,m), _gtol(gtol), _maxIterations(maxIterations), _predictor(predictor),
+      _initialStep(0.0), _minStep(0.0), _maxStep(0.0), _targetIterations(50),
+      _lambda(0.0), _lambdaOld(0.0), _history(0),
+      _totalIterations(0), _evaluations(0)
+  {}
+
+
+
+  void ContinuationSolver::resize(size_t n) {
+    _n = n;
+    _x.resize(n);
+    _g.resize(n);
+    _xOld.resize(n);
+    _x = 0.0;
+    _g = 0.0;
+    _xOld = 0.0;
+    _shared = false;
+    _memory.resize(n, _memory.capacity());
+    _history = 0;
+  }
+
+
+
+  void ContinuationSolver::_setModel(Model * model) {
+    _model = model;
+    if( _n != _model->dof() || (_shared && !_model->storageBound()) )
+      resize( _model->dof() );
+
+    if( shareModelStorage(_model, _x, _g) ) _shared = true;
+    _model->getField( *this );
+  }
+
+
+
+  void ContinuationSolver::_compute() {
+    _model->putField( *this );
+    _model->computeAndAssemble( *this, true, true, false );
+    _evaluations++;
+  }
+
+
+
+  int ContinuationSolver::_correct() {
+    const double c1 = 1.0e-4, c2 = 0.9;
+    const int maxLineSearch = 20;
+    Vector_t xs(_n), gs(_n), d(_n), s(_n), y(_n);
+
+    _compute();
+    for(int it=0; it<_maxIterations; it++) {
+      const double gnorm = LbfgsMemory::normInf(_n, _g.data());
+      if( gnorm <= _gtol ) return it;
+
+      _memory.direction(_g.data(), d.data());
+      double gd = LbfgsMemory::dot(_n, _g.data(), d.data());
+      double alpha = 1.0;
+      if( !(gd < 0.0) || _memory.pairs() == 0 ) {
+	// steepest descent, with a first step of unit max displacement
+	_memory.clear();
+	d = -_g;
+	gd = -LbfgsMemory::dot(_n, _g.data(), _g.data());
+	alpha = 1.0/gnorm;
+      }
+
+      // weak Wolfe line search by bracketing and bisection
+      xs = _x; gs = _g;
+      const double fs = _f;
+      double lo = 0.0, hi = -1.0;
+      bool accepted = false;
+      {
+	Profiler::Scope profile("ContinuationSolver::line search");
+	for(int ls=0; ls<maxLineSearch; ls++) {
+	  _x = xs + alpha*d;
+	  _compute();
+	  if( !(_f <= fs + c1*alpha*gd) ) {
+	    hi = alpha;
+	  } else if( LbfgsMemory::dot(_n, _g.data(), d.data()) < c2*gd ) {
+	    lo = alpha;
+	  } else {
+	    accepted = true;
+	    break;
+	  }
+	  alpha = ( hi < 0.0 ? 2.0*alpha : 0.5*(lo+hi) );
+	}
+      }
+      if( !accepted && lo > 0.0 ) {
+	// sufficient decrease without the curvature condition
+	_x = xs + lo*d;
+	_compute();
+	accepted = true;
+      }
+      if( !accepted ) {
+	_x = xs;
+	_compute();
+	if( _memory.pairs() > 0 ) { _memory.clear(); continue; }
+	return -1;
+      }
+
+      s = _x - xs;
+      y = _g - gs;
+      _memory.push(s.data(), y.data());
+      _totalIterations++;
+    }
+    return ( LbfgsMemory::normInf(_n, _g.data()) <= _gtol ? _maxIterations : -1 );
+  }
+
+
+
+  void ContinuationSolver::_predict(double dlambda) {
+    if( _predictor == TANGENT && _memory.pairs() > 0 ) {
+      // dx = -H [ g(x,lambda+dlambda) - g(x,lambda) ]
+      Vector_t g0(_n), dx(_n);
+      g0 = _g;
+      _compute();
+      g0 = _g - g0;
+      _memory.direction(g0.data(), dx.data());
+      _x += dx;
+      return;
+    }
+    if( _predictor != NONE && _history >= 2 && _lambda != _lambdaOld ) {
+      const double r = dlambda/(_lambda - _lambdaOld);
+      _x += r*(_x - _xOld);
+    }
+  }
+
+
+
+  int ContinuationSolver::_step(double lambda) {
+    Vector_t x0(_n), g0(_n);
+    x0 = _x; g0 = _g;
+    const double f0 = _f;
+
+    _parameter->apply(lambda);
+    _predict(lambda - _lambda);
+    const int it = _correct();
+
+    if( it < 0 ) {
+      // back to the last converged state
+      _parameter->apply(_lambda);
+      _x = x0; _g = g0; _f = f0;
+      _model->putField( *this );
+      return -1;
+    }
+
+    _xOld = x0;
+    _lambdaOld = _lambda;
+    _lambda = lambda;
+    _history = std::min(_history+1, 2);
+    return it;
+  }
+
+
+
+  int ContinuationSolver::solve(Model * model) {
+    _setModel(model);
+    const int it = _correct();
+    if( it >= 0 ) _history = std::max(_history, 1);
+    return it;
+  }
+
+
+
+  int ContinuationSolver::solve(Model * model, double lambda0, double lambda1) {
+    _setModel(model);
+    _lambda = lambda0;
+    _history = 0;
+    _parameter->apply(lambda0);
+    if( _correct() < 0 ) {
+      cout << "ContinuationSolver: no equilibrium at lambda = " << lambda0 << endl;
+      return -1;
+    }
+    _history = 1;
+    stepCompleted(_lambda, 0, 0);
+
+    const double span = lambda1 - lambda0;
+    const double dir = ( span < 0.0 ? -1.0 : 1.0 );
+    double h = ( _initialStep > 0.0 ? _initialStep : 0.1*std::abs(span) );
+    const double hmin = ( _minStep > 0.0 ? _minStep : 1.0e-6*std::abs(span) );
+    const double hmax = ( _maxStep > 0.0 ? _maxStep : std::abs(span) );
+
+    cout << setw(14) << right << "step"
+	 << setw(14) << right << "lambda"
+	 << setw(14) << right << "dlambda"
+	 << setw(14) << right << "iterations"
+	 << setw(14) << right << "f" << endl;
+
+    int step = 0;
+    while( dir*(lambda1 - _lambda) > 0.0 ) {
+      const double target = ( std::abs(lambda1 - _lambda) <= h ? lambda1 : _lambda + dir*h );
+      const int it = _step(target);
+      if( it < 0 ) {
+	h *= 0.5;
+	if( h < hmin ) {
+	  cout << "ContinuationSolver: step fell below " << hmin
+	       << " at lambda = " << _lambda << endl;
+	  return -1;
+	}
+	continue;
+      }
+      step++;
+      cout << setw(14) << right << step
+	   << setw(14) << scientific << right << _lambda
+	   << setw(14) << scientific << right << dir*h
+	   << setw(14) << right << it
+	   << setw(14) << scientific << right << _f << endl;
+      cout.unsetf(std::ios_base::scientific);
+      stepCompleted(_lambda, step, it);
+
+      const double factor = std::sqrt( double(_targetIterations)/double(std::max(it,1)) );
+      h *= std::min(2.0, std::max(0.5, factor));
+      h = std::min(hmax, std::max(hmin, h));
+    }
+    cout << "ContinuationSolver: " << step << " steps, " << _totalIterations
+	 << " iterations, " << _evaluations << " gradient evaluations." << endl;
+    return step;
+  }
+
+
+
+  int ContinuationSolver::solve(Model * model, const std::vector<double> & schedule) {
+    if( schedule.empty() ) return 0;
+    _setModel(model);
+    _lambda = schedule[0];
+    _history = 0;
+    _parameter->apply(_lambda);
+    if( _correct() < 0 ) {
+      cout << "ContinuationSolver: no equilibrium at lambda = " << _lambda << endl;
+      return -1;
+    }
+    _history = 1;
+    stepCompleted(_lambda, 0, 0);
+
+    for(int k=1; k<schedule.size(); k++) {
+      const double target = schedule[k];
+      const double span = std::abs(target - _lambda);
+      double h = span;
+      int iterations = 0;
+      while( _lambda != target ) {
+	const double next = ( std::abs(target - _lambda) <= h ? target :
+			      _lambda + (target > _lambda ? h : -h) );
+	const int it = _step(next);
+	if( it < 0 ) {
+	  h *= 0.5;
+	  if( h < 1.0e-6*span ) {
+	    cout << "ContinuationSolver: could not reach lambda = " << target << endl;
+	    return -1;
+	  }
+	  continue;
+	}
+	iterations += it;
+      }
+      stepCompleted(_lambda, k, iterations);
+    }
+    cout << "ContinuationSolver: " << schedule.size()-1 << " steps, " << _totalIterations
+	 << " iterations, " << _evaluations << " gradient evaluations." << endl;
+    return schedule.size()-1;
+  }
+
+}; // namespace voom
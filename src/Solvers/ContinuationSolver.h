@@ -0,0 +1,173 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+
+/*!
+  \file ContinuationSolver.h
+
+  \brief Quasi-static continuation in a load parameter: predictor on
+  the field, warm-started L-BFGS corrector, and adaptive load steps.
+
+*/
+
+#if !defined(__ContinuationSolver_h__)
+#define __ContinuationSolver_h__
+
+#include<iostream>
+#include<iomanip>
+#include<string>
+#include<blitz/array.h>
+#include<vector>
+#include "Solver.h"
+#include "LbfgsMemory.h"
+
+namespace voom
+{
+
+  /*!  Follows the equilibrium path x(lambda) of a Model whose energy
+    depends on a load parameter lambda (box shear, indenter
+    displacement, pressure, ...).  The user supplies the parameter
+    as a ContinuationSolver::Parameter.
+
+    Each load step
+    - predicts the new field by secant extrapolation of the last two
+      converged states, or along the tangent dx/dlambda = -H dg/dlambda
+      with H the L-BFGS inverse Hessian and dg/dlambda a finite
+      difference of the gradient;
+    - corrects with L-BFGS whose correction pairs are kept from the
+      previous steps instead of being rebuilt from scratch;
+    - adapts the next step size to the corrector iteration count
+      (growing when cheap, shrinking when expensive), and halves and
+      retries a step that fails to converge.
+
+    After every converged step stepCompleted() is called; derive from
+    this class to print or record results.
+  */
+  class ContinuationSolver : public Solver
+  {
+
+  public:
+
+    typedef blitz::Array<double,1> Vector_t;
+
+    //! The load parameter lambda
+    class Parameter
+    {
+    public:
+      virtual ~Parameter() {}
+      //! Put the model in the state of load parameter lambda
+      virtual void apply(double lambda) = 0;
+    };
+
+    enum Predictor { NONE, SECANT, TANGENT };
+
+    ContinuationSolver(Parameter * parameter, int m=5, double gtol=1.0e-5,
+		       int maxIterations=1000, Predictor predictor=SECANT);
+
+    virtual ~ContinuationSolver() {}
+
+    //! Adaptive step control
+    /*! The next step is scaled by sqrt(targetIterations/iterations),
+      limited to [0.5,2] and to [minStep,maxStep]. */
+    void setStepControl(double initialStep, double minStep, double maxStep,
+			int targetIterations=50) {
+      _initialStep = initialStep; _minStep = minStep; _maxStep = maxStep;
+      _targetIterations = targetIterations;
+    }
+
+    //! Follow the path from lambda0 to lambda1 with adaptive steps
+    int solve(Model * model, double lambda0, double lambda1);
+
+    //! Follow a fixed schedule of parameter values
+    /*! Steps that fail are bisected; the schedule values themselves
+      are always reached. */
+    int solve(Model * model, const std::vector<double> & schedule);
+
+    //! Relax at the current parameter value (warm-started L-BFGS)
+    int solve(Model * model);
+
+    //! Called after every converged step
+    virtual void stepCompleted(double lambda, int step, int iterations) {}
+
+    //! Forget stored curvature pairs and path history
+    void reset() { _memory.clear(); _history = 0; }
+
+    double lambda() const { return _lambda; }
+    int iterations() const { return _totalIterations; }
+    int gradientEvaluations() const { return _evaluations; }
+
+    double & field(int i) {return _x(i);}
+    double & function() {return _f;}
+    double & gradient(int i) {return _g(i);}
+    double & hessian(int i, int j) {
+      std::cerr << "No stiffness in ContinuationSolver." << std::endl;
+      exit(0);
+    }
+
+    const double field(int i) const {return _x(i);}
+    const double function() const {return _f;}
+    const double gradient(int i) const {return _g(i);}
+    const double hessian(int i, int j) const {
+      std::cerr << "No stiffness in ContinuationSolver." << std::endl;
+      exit(0);
+    }
+
+    const double * fieldData() const {return _x.data();}
+    const double * gradientData() const {return _g.data();}
+
+    void zeroOutData(bool f0, bool f1, bool f2) {
+      if(f0) _f=0.0;
+      if(f1) _g=0.0;
+    }
+
+    int size() const { return _n; }
+
+    void resize(size_t n);
+
+  private:
+
+    Parameter * _parameter;
+    Model * _model;
+
+    int _n;
+    double _f;
+    Vector_t _x;
+    Vector_t _g;
+    bool _shared;
+
+    LbfgsMemory _memory;
+    double _gtol;
+    int _maxIterations;
+    Predictor _predictor;
+
+    double _initialStep, _minStep, _maxStep;
+    int _targetIterations;
+
+    //! current parameter and the last two converged states
+    double _lambda, _lambdaOld;
+    Vector_t _xOld;
+    int _history;
+
+    int _totalIterations, _evaluations;
+
+    void _setModel(Model * model);
+    void _compute();
+
+    //! L-BFGS corrector; returns iterations or -1 if not converged
+    int _correct();
+
+    //! Predict the field at lambda+dlambda (parameter already applied)
+    void _predict(double dlambda);
+
+    //! One step to lambda; restores the last state on failure
+    int _step(double lambda);
+  };
+
+}; // namespace voom
+
+#endif // __ContinuationSolver_h__
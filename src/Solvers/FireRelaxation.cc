@@ -0,0 +1,217 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+
+#include<iostream>
+#include<cstdio>
+#include<cmath>
+#include<string>
+#include<algorithm>
+
+#include "FireRelaxation.h"
+#include "LbfgsMemory.h"
+
+using std::cout;
+using std::endl;
+using std::setprecision;
+
+namespace voom
+{
+
+  FireRelaxation::FireRelaxation(int n, double dt, double tol, double absTol,
+				 int maxIter, int printStride, bool debug)
+    : _dt(dt), _tol(tol), _absTol(absTol),
+      _maxIter(maxIter), _printStride(printStride), _debug(debug),
+      _dtMax(-1.0), _nDelay(5), _fInc(1.1), _fDec(0.5),
+      _alphaStart(0.1), _fAlpha(0.99), _maxStep(-1.0),
+      _stiffnessMasses(false), _updateInterval(0), _shared(false),
+      _model(0), _iterNo(0), _evaluations(0)
+  {
+    resize(n);
+  }
+
+
+
+  void FireRelaxation::resize(size_t sz) {
+    _x.resize(sz);
+    _g.resize(sz);
+    _h.resize(sz);
+    _v.resize(sz);
+    _invMass.resize(sz);
+    _size = sz;
+    _shared = false;
+    _f = 0.0;
+    _x = 0.0;
+    _g = 0.0;
+    _h = 0.0;
+    _v = 0.0;
+    _invMass = 1.0;
+  }
+
+
+
+  void FireRelaxation::_computeGradient() {
+    if(_debug) {
+      for(int i=0; i<_size; i++) {
+	if( std::abs(_x(i)) > 1.0e5 || _x(i) != _x(i) ) {
+	  std::cerr << "FireRelaxation: x(" << i << ") = " << _x(i) << endl;
+	  _model->print("End");
+	  exit(0);
+	}
+      }
+    }
+    _model->putField( *this );
+    _model->computeAndAssemble( *this, true, true, false );
+    _evaluations++;
+  }
+
+
+
+  void FireRelaxation::_computeMasses() {
+    _model->putField( *this );
+    _model->computeAndAssemble( *this, false, false, true );
+    // unit masses if the model assembles no stiffness at all
+    if( !inverseDiagonal(_h, _invMass) ) _invMass = 1.0;
+  }
+
+
+
+  int FireRelaxation::solve(Model * m)
+  {
+    _model = m;
+    if( _size != _model->dof() || (_shared && !_model->storageBound()) ) {
+      resize( _model->dof() );
+    }
+
+    if( shareModelStorage(_model, _x, _g) ) _shared = true;
+
+    _model->getField( *this );
+    const int n = _size;
+    double * x = _x.data();
+    double * v = _v.data();
+    double * invMass = _invMass.data();
+
+    _v = 0.0;
+    _invMass = 1.0;
+    _iterNo = 0;
+    _evaluations = 0;
+
+    if( _stiffnessMasses ) _computeMasses();
+    _computeGradient();
+
+    double norm = std::sqrt(LbfgsMemory::dot(n, _g.data(), _g.data()));
+    const double initialNorm = norm;
+    const double tolerance = std::max(_absTol, _tol*initialNorm);
+    if(_debug) {
+      cout << "FIRE: initial residual norm = " << norm
+	   << "    tolerance = " << tolerance << endl;
+    }
+
+    const double dtMax = ( _dtMax > 0.0 ? _dtMax : 10.0*_dt );
+    const double dtMin = 0.02*_dt;
+    double dt = _dt;
+    double alpha = _alphaStart;
+    int positive = 0;
+
+    for(int iter=0; iter<_maxIter; iter++, _iterNo++) {
+
+      if( norm < tolerance ) {
+	cout << "FIRE converged with residual norm = " << norm
+	     << " and energy = " << _f
+	     << " after " << iter << " iterations ("
+	     << _evaluations << " gradient evaluations)." << endl;
+	_model->print("fire-converged");
+	return 0;
+      }
+
+      if( _stiffnessMasses && _updateInterval > 0 && iter > 0 &&
+	  iter % _updateInterval == 0 ) {
+	_computeMasses();
+	_computeGradient();
+      }
+
+      // power F.v decides between accelerating and restarting
+      const double * g = _g.data();
+      const double power = -LbfgsMemory::dot(n, g, v);
+      if( power > 0.0 ) {
+	positive++;
+	if( positive > _nDelay ) {
+	  dt = std::min(dt*_fInc, dtMax);
+	  alpha *= _fAlpha;
+	}
+      } else {
+	positive = 0;
+	// no cut while the inertia builds up after a start
+	if( iter >= _nDelay ) dt = std::max(dt*_fDec, dtMin);
+	alpha = _alphaStart;
+	// step half back from the overshoot and stop
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+	for(int i=0; i<n; i++) {
+	  x[i] -= 0.5*dt*v[i];
+	  v[i] = 0.0;
+	}
+      }
+
+      // semi-implicit Euler with velocity mixing
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+      for(int i=0; i<n; i++) v[i] -= dt*invMass[i]*g[i];
+      const double vnorm = std::sqrt(LbfgsMemory::dot(n, v, v));
+      const double mix = ( norm > 0.0 ? alpha*vnorm/norm : 0.0 );
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+      for(int i=0; i<n; i++) v[i] = (1.0-alpha)*v[i] - mix*g[i];
+
+      double scale = dt;
+      if( _maxStep > 0.0 ) {
+	const double step = dt*LbfgsMemory::normInf(n, v);
+	if( step > _maxStep ) scale *= _maxStep/step;
+      }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+      for(int i=0; i<n; i++) x[i] += scale*v[i];
+
+      _computeGradient();
+      Profiler::count("FireRelaxation iterations");
+      norm = std::sqrt(LbfgsMemory::dot(n, _g.data(), _g.data()));
+
+      if( iter > 0 && iter % _printStride == 0 ) {
+	cout << "FIRE: iteration " << iter
+	     << setprecision( 16 )
+	     << " | residual norm = " << norm
+	     << " | energy = " << _f
+	     << " | dt = " << dt
+	     << " | alpha = " << alpha << endl;
+	char s[20];
+	sprintf(s,"%04d", iter);
+	std::string fileName(s);
+	_model->print(fileName);
+      }
+    }
+
+    if( norm < tolerance ) {
+      cout << "FIRE converged with residual norm = " << norm
+	   << " and energy = " << _f
+	   << " after " << _maxIter << " iterations ("
+	   << _evaluations << " gradient evaluations)." << endl;
+      _model->print("fire-converged");
+      return 0;
+    }
+
+    cout << "FIRE failed to converge after " << _maxIter << " iterations:" << endl
+	 << "\t initialNorm = " << initialNorm << "; norm = " << norm
+	 << "; energy = " << _f << endl;
+    return 1;
+  }
+
+}; // namespace voom
@@ -0,0 +1,186 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+//
+// Reference:
+//  E. Bitzek, P. Koskinen, F. Gahler, M. Moseler and P. Gumbsch,
+//  "Structural relaxation made simple", Phys. Rev. Lett. 97 (2006)
+//  170201.
+//  J. Guenole, W. G. Nohring, A. Vaid, F. Houlle, Z. Xie, A. Prakash
+//  and E. Bitzek, "Assessment and optimization of the fast inertial
+//  relaxation engine (FIRE) for energy minimization in atomistic
+//  simulations and its implementation in LAMMPS", Comput. Mater. Sci.
+//  175 (2020) 109584.
+//
+/////////////////////////////////////////////////////////////////////////
+
+/*!
+  \file FireRelaxation.h
+
+  \brief Fast inertial relaxation engine (FIRE), a drop-in replacement
+  for ViscousRelaxation.
+
+*/
+
+#if !defined(__FireRelaxation_h__)
+#define __FireRelaxation_h__
+
+#include<iostream>
+#include<iomanip>
+#include<string>
+#include<blitz/array.h>
+#include<vector>
+#include "Solver.h"
+
+namespace voom
+{
+
+  /*!  Same constructor and solve() as ViscousRelaxation, but instead
+    of fixed step gradient descent the dofs move as damped particles
+    (FIRE 2.0): velocities are integrated with semi-implicit Euler,
+    mixed towards the force direction by a factor alpha, and the time
+    step grows while the power F.v stays positive.  When the power
+    turns negative the system has overshot: the time step is cut, the
+    last half step undone and the velocities zeroed.  Only gradients
+    are needed and no line search is done, so kinks in the energy
+    (crosslinks that bind and unbind, contact) do not stall the
+    iteration the way they stall L-BFGS.
+
+    With setMasses(true) the mass of each dof is its diagonal
+    stiffness from the nodal hessian (Model::computeAndAssemble()
+    with f2 = true), which gives every dof a period of about one time
+    unit and allows dt ~ 0.1-1 regardless of how stiff the problem
+    is; otherwise all masses are one and dt must resolve the stiffest
+    mode, as for ViscousRelaxation.
+  */
+  class FireRelaxation : public Solver
+  {
+
+  public:
+
+    typedef blitz::Array<double,1> Vector_t;
+
+    FireRelaxation(int n,
+		   double dt=1.0e-8,
+		   double tol=1.0e-6,
+		   double absTol=1.0e-6,
+		   int maxIter=1000,
+		   int printStride=100,
+		   bool debug=false);
+
+    //! destructor
+    virtual ~FireRelaxation() {}
+
+    //! overloading pure virtual function solve()
+    int solve(Model * m);
+
+    //! FIRE parameters; dtMax <= 0 means 10 times the initial dt
+    void setParameters(double dtMax, int nDelay=5,
+		       double fInc=1.1, double fDec=0.5,
+		       double alphaStart=0.1, double fAlpha=0.99) {
+      _dtMax = dtMax;
+      _nDelay = nDelay;
+      _fInc = fInc;
+      _fDec = fDec;
+      _alphaStart = alphaStart;
+      _fAlpha = fAlpha;
+    }
+
+    //! Largest displacement of any dof in one step (<= 0 for no limit)
+    void setMaxStep(double maxStep) { _maxStep = maxStep; }
+
+    //! Masses from the diagonal stiffness, recomputed every
+    //! updateInterval steps (only at the start if <= 0)
+    void setMasses(bool fromStiffness, int updateInterval=0) {
+      _stiffnessMasses = fromStiffness;
+      _updateInterval = updateInterval;
+    }
+
+    double & field(int i) {return _x(i);}
+    double & function() {return _f;}
+    double & gradient(int i) {return _g(i);}
+    double & hessian(int i) {return _h(i);}
+    double & hessian(int i, int j) {
+      std::cerr << "No stiffness in FireRelaxation solver." << std::endl;
+      exit(0);
+    }
+
+    const double field(int i) const {return _x(i);}
+    const double function() const {return _f;}
+    const double gradient(int i) const {return _g(i);}
+    const double hessian(int i) const {return _h(i);}
+    const double hessian(int i, int j) const {
+      std::cerr << "No stiffness in FireRelaxation solver." << std::endl;
+      exit(0);
+    }
+
+    const double * fieldData() const {return _x.data();}
+    const double * gradientData() const {return _g.data();}
+
+    double * field() { return _x.data();}
+    double * gradient() { return _g.data();}
+
+    void zeroOutData(bool f0, bool f1, bool f2) {
+      if(f0) _f=0.0;
+      if(f1) _g=0.0;
+      if(f2) _h=0.0;
+    }
+
+    void resize(size_t sz);
+
+    int size() const { return _size;}
+
+    int iterationNo() const {return _iterNo;}
+
+    //! Gradient evaluations in the last solve
+    int evaluations() const {return _evaluations;}
+
+  private:
+
+    Vector_t _x;
+    Vector_t _g;
+    Vector_t _h;
+    Vector_t _v;
+    Vector_t _invMass;
+
+    double _f;
+    double _dt;
+    double _tol;
+    double _absTol;
+
+    size_t _size;
+
+    int _maxIter;
+    int _printStride;
+
+    bool _debug;
+
+    double _dtMax;
+    int _nDelay;
+    double _fInc, _fDec, _alphaStart, _fAlpha;
+    double _maxStep;
+
+    bool _stiffnessMasses;
+    int _updateInterval;
+
+    //! true if _x and _g are views of the model's bound storage
+    bool _shared;
+
+    Model * _model;
+
+    int _iterNo;
+    int _evaluations;
+
+    void _computeGradient();
+
+    void _computeMasses();
+  };
+
+}; // namespace voom
+
+#endif // __FireRelaxation_h__
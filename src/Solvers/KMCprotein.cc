@@ -86,6 +86,7 @@ namespace voom {
 	  double p = double(rand())/double(RAND_MAX);
 	  if (p < _rates[i]) { // accept move
 	    _proteins[i]->setHost(_tempHosts[i]);
+	    _moved(i);
 	    accepted++;
 	  }  
 	} // loop over all proteins
@@ -97,6 +98,7 @@ namespace voom {
 	  double p = double(rand())/double(RAND_MAX);
 	  if (p < r_i || r_i > 1.0-1.0e-16) { // accept move
 	    _proteins[i]->setHost(_tempHosts[i]);
+	    _moved(i);
 	    accepted++;
 	  }  
 	} // loop over all proteins
@@ -143,6 +145,7 @@ namespace voom {
       // Recompute Neighbors
       if (step%ComputeNeighInterval == 0) {
 	_body->recomputeNeighbors(Rsearch);
+	_dirty.assign(_proteinsSize, true);
       }
 
       // Lower temperature for next MC iteration
@@ -187,6 +190,7 @@ namespace voom {
 	    // OriginalLocations[pt] = (_proteins[pt]->getHost())->point();
 	  }
 	  _body->recomputeNeighbors(Rsearch);
+	  _dirty.assign(_proteinsSize, true);
 	  _printProtein->printMaster(-step, 0);
 	  // Reset time to zero
 	  _time = 0.0;
@@ -218,28 +222,52 @@ namespace voom {
 // --------------------------------------------------------------
   void KMCprotein::computeRates()
   { 
+    if (_deltas.size() != _proteinsSize) {
+      _deltas.resize(_proteinsSize);
+      _known.resize(_proteinsSize);
+      _dirty.assign(_proteinsSize, true);
+    }
+
     for (int i = 0; i < _proteinsSize; i++)
     { 
       ProteinNode * A = _proteins[i];
       DeformationNode<3> * hostA = A->getHost();
 
-      vector<DeformationNode<3> *> NewHosts = _possibleHosts[hostA];
+      const vector<DeformationNode<3> *> & NewHosts = _possibleHosts[hostA];
       // std::uniform_int_distribution<int> IntDistribution(0, NewHosts.size()-1);
       // uint j = IntDistribution(generator);
       uint j = rand()%NewHosts.size();
-      A->setHost(NewHosts[j]);
       _tempHosts[i] = NewHosts[j]; // If this move is later kept, need to remember where protein went
-      
-      // Compute body energy
-      _body->compute(true, false, false);
-      _rates[i] = exp( ( _fSaved - _body->energy())/_T1 );
-      A->setHost(hostA); // return protein in position at the beginning of time step
+
+      // Energy changes of the moves of protein i only depend on its
+      // neighborhood; they are kept until it or a neighbor moves
+      if (_dirty[i]) {
+	_known[i].assign(NewHosts.size(), false);
+	_deltas[i].resize(NewHosts.size());
+	_dirty[i] = false;
+      }
+      if (!_known[i][j]) {
+	_deltas[i][j] = _body->deltaEnergy(A, NewHosts[j]);
+	_known[i][j] = true;
+      }
+      _rates[i] = exp( -_deltas[i][j]/_T1 );
     }
       
   } // computeRates
 
 
 
+  void KMCprotein::_moved(int i)
+  {
+    _dirty[i] = true;
+    _body->coupledProteins(i, _coupled);
+    for (uint k = 0; k < _coupled.size(); k++) {
+      _dirty[_coupled[k]] = true;
+    }
+  } // _moved
+
+
+
   vector<double > KMCprotein::ComputeUavgSquare(vector<DeformationNode<3>::Point > & OriginalLocations) 
   {
     double uSQavgTot = 0.0, uSQavgTails = 0.0, uSQavgCenter = 0.0, Increment = 0.0;
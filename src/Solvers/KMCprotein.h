@@ -95,6 +95,11 @@ namespace voom
     virtual ~KMCprotein() {};
 
     void solve(uint ComputeNeighInterval, double Rsearch);
+    //! Rates of one random trial move per protein
+    /*! Uses ProteinBody::deltaEnergy, and caches the energy change
+      of each trial move until the protein or one of its neighbors
+      moves, so only the rates of affected proteins are recomputed.
+    */
     void computeRates();
     void computeRmax(){ _rmax = *(max_element( _rates.begin(), _rates.end() ) ); };
 
@@ -126,6 +131,15 @@ namespace voom
 
     vector<double > _rates;
 
+    // Cached energy changes of the possible moves of each protein
+    vector<vector<double > > _deltas;
+    vector<vector<bool > > _known;
+    vector<bool > _dirty;
+    vector<uint > _coupled;
+
+    //! Invalidate cached moves of protein i and its neighbors
+    void _moved(int i);
+
     int _printEvery;
     unsigned int _nSteps;
     int _NT;
@@ -0,0 +1,153 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+//
+// Reference:
+//  J. Nocedal and S. J. Wright, Numerical Optimization, 2nd ed.,
+//  Springer (2006), Algorithm 7.4 (L-BFGS two-loop recursion).
+//
+/////////////////////////////////////////////////////////////////////////
+
+/*!
+  \file LbfgsMemory.h
+
+  \brief Limited memory BFGS correction pairs and the two-loop
+  recursion, kept separate from any one solver so that the curvature
+  information can outlive a single solve.
+
+*/
+
+#if !defined(__LbfgsMemory_h__)
+#define __LbfgsMemory_h__
+
+#include<vector>
+#include<cmath>
+
+namespace voom
+{
+
+  /*!  Ring buffer of the last m pairs s = x_{k+1}-x_k,
+    y = g_{k+1}-g_k, applied as the inverse Hessian approximation H
+    with the usual two-loop recursion.  An optional diagonal
+    preconditioner P (approximating the inverse of the diagonal of the
+    Hessian) replaces the scalar initial matrix gamma*I.
+  */
+  class LbfgsMemory
+  {
+  public:
+
+    LbfgsMemory(int n=0, int m=5) { resize(n,m); }
+
+    void resize(int n, int m) {
+      _n = n; _m = m;
+      _s.assign(n*m, 0.0);
+      _y.assign(n*m, 0.0);
+      _rho.assign(m, 0.0);
+      _alpha.assign(m, 0.0);
+      clear();
+    }
+
+    //! Forget all pairs
+    void clear() { _k = 0; _first = 0; _gamma = 1.0; }
+
+    int size() const { return _n; }
+    int pairs() const { return _k; }
+    int capacity() const { return _m; }
+    double gamma() const { return _gamma; }
+
+    //! Store a pair; rejected (returns false) unless s.y > eps |s||y|
+    bool push(const double * s, const double * y, double eps=1.0e-10) {
+      if(_m == 0) return false;
+      const double sy = dot(_n, s, y), yy = dot(_n, y, y), ss = dot(_n, s, s);
+      if( !(sy > eps*std::sqrt(ss*yy)) ) return false;
+      int slot;
+      if(_k < _m) slot = (_first + _k++) % _m;
+      else { slot = _first; _first = (_first+1) % _m; }
+      double * sk = &_s[slot*_n];
+      double * yk = &_y[slot*_n];
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+      for(int i=0; i<_n; i++) { sk[i] = s[i]; yk[i] = y[i]; }
+      _rho[slot] = 1.0/sy;
+      _gamma = sy/yy;
+      return true;
+    }
+
+    //! d = -H g
+    /*! If P is not null it is the diagonal initial inverse Hessian;
+      otherwise gamma*I is used, gamma = s.y/y.y of the newest pair. */
+    void direction(const double * g, double * d, const double * P=0) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+      for(int i=0; i<_n; i++) d[i] = -g[i];
+      for(int j=_k-1; j>=0; j--) {
+	const int slot = (_first + j) % _m;
+	_alpha[slot] = _rho[slot]*dot(_n, &_s[slot*_n], d);
+	axpy(_n, -_alpha[slot], &_y[slot*_n], d);
+      }
+      if(P) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+	for(int i=0; i<_n; i++) d[i] *= P[i];
+      } else {
+	scale(_n, _gamma, d);
+      }
+      for(int j=0; j<_k; j++) {
+	const int slot = (_first + j) % _m;
+	const double beta = _rho[slot]*dot(_n, &_y[slot*_n], d);
+	axpy(_n, _alpha[slot]-beta, &_s[slot*_n], d);
+      }
+    }
+
+    //! Parallel BLAS-1 helpers
+    static double dot(int n, const double * a, const double * b) {
+      double sum = 0.0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+:sum) schedule(static)
+#endif
+      for(int i=0; i<n; i++) sum += a[i]*b[i];
+      return sum;
+    }
+
+    //! y += alpha x
+    static void axpy(int n, double alpha, const double * x, double * y) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+      for(int i=0; i<n; i++) y[i] += alpha*x[i];
+    }
+
+    static void scale(int n, double alpha, double * x) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+      for(int i=0; i<n; i++) x[i] *= alpha;
+    }
+
+    //! max |a_i|
+    static double normInf(int n, const double * a) {
+      double m = 0.0;
+      for(int i=0; i<n; i++) m = std::max(m, std::abs(a[i]));
+      return m;
+    }
+
+  private:
+
+    int _n, _m;
+    //! number of stored pairs and slot of the oldest
+    int _k, _first;
+    std::vector<double> _s, _y, _rho, _alpha;
+    double _gamma;
+  };
+
+}; // namespace voom
+
+#endif // __LbfgsMemory_h__
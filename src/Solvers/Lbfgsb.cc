@@ -62,6 +62,7 @@ namespace voom
     cout << " and initializing arrays to zero";
     cout.flush();
     _n = n;
+    _shared = false;
     _f = 0.0;
     _x = 0.0;
     _g = 0.0;
@@ -93,11 +94,14 @@ namespace voom
 
     _model = m;
     // resize arrays if necessary
-    if( _n != _model->dof() || _x.size() != _model->dof() ) {
+    if( _n != _model->dof() || _x.size() != _model->dof() ||
+	(_shared && !_model->storageBound()) ) {
       resize( _model->dof() );
     }
     assert( _x.size() == _model->dof() );
 
+    if( shareModelStorage(_model, _x, _g) ) _shared = true;
+
     // copy starting guess from model
     _model->getField( *this );
       
@@ -140,14 +144,18 @@ namespace voom
     while(true) {
       
       // This is the call to the L-BFGS-B code.
-      setulb_(&_n, &_m, _x.data(), _l.data(), _u.data(), _nbd.data(), 
-	      &_f, _g.data(), &_factr, &_pgtol, _wa.data(),_iwa.data(), 
-	      &(task[0]), &iprint, &(csave[0]),
-	      &(lsave[0]),&(isave[0]),&(dsave[0])); 
+      {
+	Profiler::Scope profile("Lbfgsb::setulb");
+	setulb_(&_n, &_m, _x.data(), _l.data(), _u.data(), _nbd.data(), 
+		&_f, _g.data(), &_factr, &_pgtol, _wa.data(),_iwa.data(), 
+		&(task[0]), &iprint, &(csave[0]),
+		&(lsave[0]),&(isave[0]),&(dsave[0])); 
+      }
       if(strncmp(task,"FG",2)==0) {
 	// The minimization routine has returned to request the
 	// function f and gradient g values at the current x.
 
+	Profiler::Scope profile("Lbfgsb::line search evaluation");
 	_computeAll();
 
 	// Go back to the minimization routine.
@@ -155,6 +163,7 @@ namespace voom
       }
 
       else if( strncmp(task,"NEW_X",5)==0 ) {
+	Profiler::count("Lbfgsb iterations");
 	// stop if maximum number of iterations has been reached
 	if ( _maxIterations > 0 && isave[29] > _maxIterations ) {
 	  break;
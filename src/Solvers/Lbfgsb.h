@@ -87,6 +87,9 @@ namespace voom
     const blitz::Array<double,1> & gradient() const {return _g;}
     const blitz::Array<double,2> & hessian() const;
 
+    const double * fieldData() const {return _x.data();}
+    const double * gradientData() const {return _g.data();}
+
     double projectedGradientNorm() const {return _projg;}
 
     void zeroOutData(bool f0, bool f1, bool f2) {
@@ -125,6 +128,9 @@ namespace voom
 
     bool _debug;
 
+    //! true if _x and _g are views of the model's bound storage
+    bool _shared;
+
     Model * _model;
 
     int _iterNo;
@@ -0,0 +1,296 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+
+#include<iostream>
+#include<cmath>
+#include<limits>
+#include<algorithm>
+
+#include "LbfgsbNative.h"
+
+using std::cout;
+using std::endl;
+using std::setw;
+using std::right;
+using std::scientific;
+
+namespace voom
+{
+
+  LbfgsbNative::LbfgsbNative(int n, int m, double factr, double pgtol,
+			     int iprint, int maxIterations, bool debug)
+    : _memory(0,m), _n(0), _m(m), _factr(factr), _pgtol(pgtol),
+      _iprint(iprint), _maxIterations(maxIterations), _debug(debug),
+      _precondition(false), _scaled(false), _updateInterval(0), _callback(0),
+      _out(&std::cout), _shared(false), _model(0), _iterNo(0), _evaluations(0),
+      _projg(0.0)
+  {
+    resize(n);
+  }
+
+
+
+  void LbfgsbNative::resize(size_t n)  {
+    _n = n;
+    _x.resize(n);
+    _g.resize(n);
+    _h.resize(n);
+    _l.resize(n);
+    _u.resize(n);
+    _nbd.resize(n);
+    _P.resize(n);
+    _memory.resize(n, _m);
+    _shared = false;
+    _f = 0.0;
+    _x = 0.0;
+    _g = 0.0;
+    _h = 0.0;
+    _l = 0.0;
+    _u = 0.0;
+    _nbd = 0;
+    _P = 1.0;
+  }
+
+
+
+  void LbfgsbNative::setBounds(const IntArray & nbd,
+			       const Vector_t & l, const Vector_t & u) {
+    if(nbd.size() != _n || l.size() != _n || u.size() != _n ) {
+      cout << "LbfgsbNative::setBounds(): input arrays are incorrectly sized."
+	   << endl;
+      return;
+    }
+    _nbd = nbd;
+    _l = l;
+    _u = u;
+    return;
+  }
+
+
+
+  void LbfgsbNative::_computeAll() {
+    if(_debug) {
+      for(int i=0; i<_n; i++) {
+	if( std::abs(_x(i)) > 1.0e5 || _x(i) != _x(i) ) {
+	  std::cerr << "LbfgsbNative: x(" << i << ") = " << _x(i) << endl;
+	  _model->print("End");
+	  exit(0);
+	}
+      }
+    }
+    _model->putField( *this );
+    _model->computeAndAssemble( *this, true, true, false );
+    _evaluations++;
+  }
+
+
+
+  void LbfgsbNative::_computePreconditioner() {
+    _model->putField( *this );
+    _model->computeAndAssemble( *this, false, false, true );
+    // without any assembled stiffness keep the L-BFGS gamma scaling
+    _scaled = inverseDiagonal(_h, _P);
+  }
+
+
+
+  void LbfgsbNative::_project(Vector_t & x) const {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(int i=0; i<_n; i++) {
+      const int b = _nbd(i);
+      if( (b == 1 || b == 2) && x(i) < _l(i) ) x(i) = _l(i);
+      if( (b == 2 || b == 3) && x(i) > _u(i) ) x(i) = _u(i);
+    }
+  }
+
+
+
+  double LbfgsbNative::_freeVariables(std::vector<char> & free) const {
+    double projg = 0.0;
+#if defined(_OPENMP) && (_OPENMP >= 201107)
+#pragma omp parallel for reduction(max:projg) schedule(static)
+#endif
+    for(int i=0; i<_n; i++) {
+      const int b = _nbd(i);
+      const double g = _g(i);
+      // projected gradient: the step x - g clipped to the bounds
+      double pg = g;
+      if( (b == 1 || b == 2) && g > 0.0 ) pg = std::min(g, _x(i) - _l(i));
+      if( (b == 2 || b == 3) && g < 0.0 ) pg = std::max(g, _x(i) - _u(i));
+      // variables at a bound, pushed outward, are held fixed
+      const double eps = 1.0e-12*(1.0 + std::abs(_x(i)));
+      bool fixed = false;
+      if( (b == 1 || b == 2) && _x(i) <= _l(i) + eps && g > 0.0 ) fixed = true;
+      if( (b == 2 || b == 3) && _x(i) >= _u(i) - eps && g < 0.0 ) fixed = true;
+      free[i] = !fixed;
+      projg = std::max(projg, std::abs(pg));
+    }
+    return projg;
+  }
+
+
+
+  int LbfgsbNative::solve(Model * m) {
+
+    _model = m;
+    if( _n != _model->dof() || (_shared && !_model->storageBound()) ) {
+      resize( _model->dof() );
+    }
+
+    if( shareModelStorage(_model, _x, _g) ) _shared = true;
+
+    _model->getField( *this );
+    _project(_x);
+
+    const double c1 = 1.0e-4;
+    const double epsmch = std::numeric_limits<double>::epsilon();
+    const int maxLineSearch = 30;
+    Vector_t xs(_n), gs(_n), d(_n), s(_n), y(_n), gF(_n), PF(_n);
+    std::vector<char> free(_n, 1);
+
+    _memory.clear();
+    _iterNo = 0;
+    _evaluations = 0;
+
+    (*_out) << "================================================================================"
+	 << endl << endl
+	 << "Starting BFGS iterations (native"
+	 << (_precondition ? ", preconditioned" : "") << ")."
+	 << endl << endl;
+
+    (*_out) << setw(14) << scientific << right << "|proj g|"
+	 << setw(14) << scientific << right << "|g|"
+	 << setw(14) << scientific  << right << "f"
+	 << setw(14) << right << "iterations"
+	 << setw(14) << right << "evaluations"
+	 << endl
+	 << "--------------------------------------------------------------------------------"
+	 << endl;
+
+    _scaled = false;
+    if( _precondition ) _computePreconditioner();
+    _computeAll();
+    std::string task = "ABNORMAL_TERMINATION_IN_LNSRCH";
+
+    while(true) {
+      _projg = _freeVariables(free);
+      if( _projg <= _pgtol ) {
+	task = "CONVERGENCE: NORM_OF_PROJECTED_GRADIENT_<=_PGTOL";
+	break;
+      }
+      if( _maxIterations > 0 && _iterNo >= _maxIterations ) {
+	task = "STOP: TOTAL NO. of ITERATIONS EXCEEDS LIMIT";
+	break;
+      }
+
+      if( _precondition && _updateInterval > 0 && _iterNo > 0 &&
+	  _iterNo % _updateInterval == 0 ) {
+	_computePreconditioner();
+	_computeAll();
+      }
+
+      // search direction on the free variables
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+      for(int i=0; i<_n; i++) {
+	gF(i) = ( free[i] ? _g(i) : 0.0 );
+	PF(i) = ( free[i] ? _P(i) : 0.0 );
+      }
+      const double * P = ( _scaled ? PF.data() : 0 );
+      double alpha = 1.0;
+      if( _memory.pairs() > 0 ) {
+	_memory.direction(gF.data(), d.data(), P);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+	for(int i=0; i<_n; i++) if( !free[i] ) d(i) = 0.0;
+      }
+      double gd = LbfgsMemory::dot(_n, _g.data(), d.data());
+      if( _memory.pairs() == 0 || !(gd < 0.0) ) {
+	// (preconditioned) steepest descent
+	_memory.clear();
+	if( _scaled ) d = -PF*gF;
+	else d = -gF;
+	gd = LbfgsMemory::dot(_n, _g.data(), d.data());
+	if( !_scaled ) alpha = 1.0/std::max(LbfgsMemory::normInf(_n, d.data()), 1.0);
+      }
+
+      // projected backtracking line search
+      xs = _x; gs = _g;
+      const double fs = _f;
+      bool accepted = false;
+      {
+	Profiler::Scope profile("LbfgsbNative::line search");
+	for(int ls=0; ls<maxLineSearch; ls++) {
+	  _x = xs + alpha*d;
+	  _project(_x);
+	  _computeAll();
+	  s = _x - xs;
+	  const double decrease = LbfgsMemory::dot(_n, gs.data(), s.data());
+	  if( _f <= fs + c1*decrease ) { accepted = true; break; }
+	  alpha *= 0.5;
+	}
+      }
+      if( !accepted ) {
+	_x = xs;
+	_computeAll();
+	if( _memory.pairs() > 0 ) { _memory.clear(); continue; }
+	break;
+      }
+
+      y = _g - gs;
+      _memory.push(s.data(), y.data());
+      _iterNo++;
+      Profiler::count("LbfgsbNative iterations");
+
+      if ( _iprint>0 && _iterNo%_iprint == 0 ) {
+	_model->print(_prefix + "lbfgsbiter");
+	(*_out) << setw(14) << scientific << right << _projg
+	     << setw(14) << scientific << right << blitz::max(blitz::abs(_g))
+	     << setw(14) << scientific  << right << _f
+	     << setw(14) << right << _iterNo
+	     << setw(14) << right << _evaluations
+	     << endl;
+      }
+
+      if( _callback && !_callback->iteration(_iterNo, _f, _projg, _x, _g) ) {
+	task = "STOP: CALLBACK";
+	break;
+      }
+
+      // relative reduction of f, as in L-BFGS-B
+      const double scale = std::max(std::max(std::abs(fs), std::abs(_f)), 1.0);
+      if( fs - _f <= _factr*epsmch*scale ) {
+	task = "CONVERGENCE: REL_REDUCTION_OF_F_<=_FACTR*EPSMCH";
+	break;
+      }
+    }
+
+    _projg = _freeVariables(free);
+    (*_out) << task << endl;
+    if( task.compare(0,4,"CONV") == 0 ) _model->print(_prefix + "lbfgsbconv");
+    else if( task.compare(0,6,"ABNORM") == 0 ) _model->print(_prefix + "abnormal");
+
+    (*_out) << setw(14) << scientific << right << _projg
+	 << setw(14) << scientific << right << blitz::max(blitz::abs(_g))
+	 << setw(14) << scientific << right << _f
+	 << setw(14) << right << _iterNo
+	 << setw(14) << right << _evaluations
+	 << endl << endl
+	 << "================================================================================"
+	 << endl << endl;
+
+    _out->unsetf(std::ios_base::scientific);
+    return 0;
+  }
+
+}; // namespace voom
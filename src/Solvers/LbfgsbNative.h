@@ -0,0 +1,206 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+//
+// Reference:
+//  D. P. Bertsekas, "Projected Newton methods for optimization
+//  problems with simple constraints", SIAM J. Control Optim. 20
+//  (1982) 221-246.
+//  J. Nocedal and S. J. Wright, Numerical Optimization, 2nd ed.,
+//  Springer (2006), Ch. 7.
+//
+/////////////////////////////////////////////////////////////////////////
+
+/*!
+  \file LbfgsbNative.h
+
+  \brief C++ limited memory BFGS solver with simple bounds and an
+  optional diagonal preconditioner, a drop-in replacement for the
+  Fortran based Lbfgsb.
+
+*/
+
+#if !defined(__LbfgsbNative_h__)
+#define __LbfgsbNative_h__
+
+#include<iostream>
+#include<iomanip>
+#include<string>
+#include<blitz/array.h>
+#include<vector>
+#include "Solver.h"
+#include "LbfgsMemory.h"
+
+namespace voom
+{
+
+  /*!  Same constructor, setBounds() and solve() as Lbfgsb, but
+    implemented in C++ as a projected L-BFGS method: variables at a
+    bound whose gradient pushes them outward are held fixed, the
+    L-BFGS two-loop recursion acts on the free variables, and a
+    projected backtracking line search keeps iterates feasible.  All
+    vector operations are OpenMP parallel and the solver works in
+    place on bound model storage (Model::bindStorage).
+
+    With setPreconditioner(true) the initial inverse Hessian of the
+    two-loop recursion is diag(1/K_ii), built from the nodal diagonal
+    stiffness that Model::computeAndAssemble() assembles (f2 = true),
+    instead of a scalar.  This matters for badly scaled problems such
+    as shells with stiff bending.
+
+    A Callback, if set, is called after every iteration and may stop
+    the iteration.
+  */
+  class LbfgsbNative : public Solver
+  {
+
+  public:
+
+    typedef blitz::Array<double,1> Vector_t;
+    typedef blitz::Array<int,1> IntArray;
+
+    //! Per-iteration observer
+    class Callback
+    {
+    public:
+      virtual ~Callback() {}
+      //! Return false to stop the iteration
+      virtual bool iteration(int k, double f, double projg,
+			     const Vector_t & x, const Vector_t & g) = 0;
+    };
+
+    //! Default Constructor
+    LbfgsbNative(int n, int m=5,
+		 double factr=1.0e+1, double pgtol=1.0e-5,
+		 int iprint=0, int maxIterations=-1, bool debug=false);
+
+    //! destructor
+    virtual ~LbfgsbNative() {}
+
+    double & field(int i) {return _x(i);}
+    double & function() {return _f;}
+    double & gradient(int i) {return _g(i);}
+    double & hessian(int i) {return _h(i);}
+    double & hessian(int i, int j) {
+      std::cerr << "No stiffness in LbfgsbNative solver." << std::endl;
+      exit(0);
+    }
+
+    const double field(int i) const {return _x(i);}
+    const double function() const {return _f;}
+    const double gradient(int i) const {return _g(i);}
+    const double hessian(int i) const {return _h(i);}
+    const double hessian(int i, int j) const {
+      std::cerr << "No stiffness in LbfgsbNative solver." << std::endl;
+      exit(0);
+    }
+
+    const blitz::Array<double,1> & gradient() const {return _g;}
+
+    const double * fieldData() const {return _x.data();}
+    const double * gradientData() const {return _g.data();}
+
+    double projectedGradientNorm() const {return _projg;}
+
+    void zeroOutData(bool f0, bool f1, bool f2) {
+      if(f0) _f=0.0;
+      if(f1) _g=0.0;
+      if(f2) _h=0.0;
+    }
+
+    //! Bounds as in Lbfgsb: nbd = 0 free, 1 lower, 2 both, 3 upper
+    void setBounds(const IntArray & nbd,
+		   const Vector_t & l, const Vector_t & u);
+
+    //! Diagonal preconditioning from the nodal stiffness
+    /*! The diagonal is recomputed every updateInterval iterations
+      (only once per solve if updateInterval <= 0).  Dof without an
+      assembled diagonal use the mean of the others; if the model
+      assembles no stiffness at all the usual gamma scaling is kept. */
+    void setPreconditioner(bool precondition, int updateInterval=0) {
+      _precondition = precondition;
+      _updateInterval = updateInterval;
+    }
+
+    void setCallback(Callback * callback) {_callback = callback;}
+
+    //! Prefix for the files written on termination (e.g. a directory)
+    void setOutputPrefix(const std::string & prefix) {_prefix = prefix;}
+
+    //! Stream for the iteration table (std::cout by default)
+    void setOutputStream(std::ostream & out) {_out = &out;}
+
+    int size() const { return _n;}
+
+    void resize(size_t n);
+
+    //! overloading pure virtual function solve()
+    int solve(Model * m);
+
+    int iterationNo() {return _iterNo;}
+
+    int evaluations() {return _evaluations;}
+
+  private:
+
+    double _f;
+    Vector_t _x;
+    Vector_t _g;
+    Vector_t _h;
+    Vector_t _l;
+    Vector_t _u;
+    IntArray _nbd;
+
+    //! diagonal preconditioner, zero on fixed variables
+    Vector_t _P;
+
+    LbfgsMemory _memory;
+
+    int _n, _m;
+    double _factr, _pgtol;
+    int _iprint;
+
+    int _maxIterations;
+
+    bool _debug;
+
+    bool _precondition;
+    //! true if _P holds a preconditioner; false falls back to gamma scaling
+    bool _scaled;
+    int _updateInterval;
+
+    Callback * _callback;
+
+    std::string _prefix;
+
+    std::ostream * _out;
+
+    //! true if _x and _g are views of the model's bound storage
+    bool _shared;
+
+    Model * _model;
+
+    int _iterNo;
+    int _evaluations;
+
+    double _projg;
+
+    void _computeAll();
+
+    void _computePreconditioner();
+
+    //! Project x onto the bounds
+    void _project(Vector_t & x) const;
+
+    //! Mark free variables (1) and return the projected gradient norm
+    double _freeVariables(std::vector<char> & free) const;
+  };
+
+}; // namespace voom
+
+#endif // __LbfgsbNative_h__
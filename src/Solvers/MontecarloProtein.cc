@@ -170,9 +170,12 @@ namespace voom {
 	_printProtein->printMaster(int(step/_printEvery), 0);
       }
 
-      // Recompute Neighbors
+      // Recompute Neighbors; the energy changes with the neighbor
+      // lists and also drifts with incremental updates, so resync it
       if (step%ComputeNeighInterval == 0) {
 	_body->recomputeNeighbors(Rsearch);
+	_body->compute(true, false, false);
+	_fSaved = _f = _body->energy();
       }
 
       // Lower temperature for next MC iteration
@@ -245,38 +248,47 @@ namespace voom {
 
 
 
+  unsigned int MontecarloProtein::sweep()
+  {
+    unsigned int accepted = 0;
+    for(uint pt = 0; pt < _proteins.size(); pt++)
+    {
+      if( changeState() ) accepted++;
+    }
+    return accepted;
+  } // sweep
+
+
+
 // --------------------------------------------------------------
 // Compute a new random trial state based on chosen distribution
 // --------------------------------------------------------------
   bool MontecarloProtein::changeState()
   { 
-      uint i = rand()%_proteins.size();
+      uint i = _randomIndex(_proteins.size());
       
       ProteinNode * A = _proteins[i];
       DeformationNode<3> * hostA = A->getHost();
-      vector<DeformationNode<3> *> NewHosts = _possibleHosts[hostA];
+      // find() rather than operator[] so that instances on several
+      // threads can share the map
+      const vector<DeformationNode<3> *> & NewHosts = _possibleHosts.find(hostA)->second;
  
-      uint j = rand()%NewHosts.size();
-      A->setHost(NewHosts[j]);
+      uint j = _randomIndex(NewHosts.size());
 
-      
-      // Compute body energy
-      _body->compute(true, false, false);
-      _f = _body->energy();
-    
-      // Decide whether or not to keep the new state
-      double df = _f - _fSaved; 
+      // Only the terms involving A change
+      double df = _body->deltaEnergy(A, NewHosts[j]);
+      _f = _fSaved + df;
        
       // metropolis
-      double p = double(rand())/double(RAND_MAX);
+      double p = _uniform();
       // cout << "df = " << df << endl;
       if( df < 0.0 || p < exp( -df/_T1 ) )
       { 
+	_body->commitMove(A, NewHosts[j], df);
 	_fSaved = _f;
 	return true;
       }
       else {
-	A->setHost(hostA);
 	return false;  
       }
   } // changeState
@@ -289,14 +301,14 @@ namespace voom {
     std::map<uint, DeformationNode<3> *> ProteinsChanged;
 
     for(uint pt = 0; pt < Psize; pt++) {
-      uint i = rand()%Psize;
+      uint i = _randomIndex(Psize);
 
       ProteinNode * A = _proteins[i];
       DeformationNode<3> * hostA = A->getHost();
       ProteinsChanged.insert(make_pair(i, hostA));
       vector<DeformationNode<3> *> NewHosts = _possibleHosts[hostA];
  
-      uint j = rand()%NewHosts.size();
+      uint j = _randomIndex(NewHosts.size());
       A->setHost(NewHosts[j]);
     } // change position of all proteins at once
       
@@ -308,7 +320,7 @@ namespace voom {
     double df = _f - _fSaved; 
     
     // metropolis
-    double p = double(rand())/double(RAND_MAX);
+    double p = _uniform();
     // cout << "df = " << df << endl;
     if( df < 0.0 || p < exp( -df/_T1 ) ) { 
       _fSaved = _f;
@@ -329,7 +341,7 @@ namespace voom {
   {
     ProteinPotential * Mat = _body->getPotential();
     double CurrentReq = Mat->getEquilibriumR();
-    double NewReq = ( (double(rand())/double(RAND_MAX) - 0.5) * 0.1 + 1.0)*CurrentReq;
+    double NewReq = ( (_uniform() - 0.5) * 0.1 + 1.0)*CurrentReq;
     
     Mat->setEquilibriumR(NewReq);
     
@@ -341,7 +353,7 @@ namespace voom {
     double df = _f - _fSaved; 
     
     // metropolis
-    double p = double(rand())/double(RAND_MAX);
+    double p = _uniform();
     if( df < 0.0 || p < exp( -df/_T1 ) )
     { 
       _fSaved = _f;
@@ -32,6 +32,7 @@
 
 
 #include "ProteinBody.h"
+#include "RandomStream.h"
 #include "../Applications/Archaea/Utils/PrintingProtein.h"
 
 using namespace std;
@@ -70,7 +71,7 @@ namespace voom
       _method(Method),
       _printProtein(PrintProtein), _resetT(ResetT), _printEvery(PrintEvery),
       _nSteps(NSteps), _NT(NT), _length(Length), _Zmin(Zmin), _Zmax(Zmax),
-      _print(print), _f(0.0), _fSaved(0.0) {};
+      _print(print), _f(0.0), _fSaved(0.0), _T1(0.0), _rng(0) {};
     
     //! destructor
     virtual ~MontecarloProtein() {};
@@ -92,6 +93,28 @@ namespace voom
     }
 
     vector<double > ComputeUavgSquare(vector<DeformationNode<3>::Point > & OriginalLocations);
+
+    //! Draw random numbers from rng instead of the global rand()
+    /*! Needed when several MontecarloProtein instances run on
+      different threads (see ReplicaExchangeProtein). */
+    void setRandomStream(RandomStream * rng) { _rng = rng; }
+
+    //! Metropolis temperature used by changeState()
+    void setTemperature(double T) { _T1 = T; }
+    double temperature() const { return _T1; }
+
+    //! Recompute the energy of the current state from scratch
+    double resetEnergy() {
+      _body->compute(true, false, false);
+      _f = _fSaved = _body->energy();
+      return _fSaved;
+    }
+
+    //! Energy of the current state
+    double energy() const { return _fSaved; }
+
+    //! One changeState() attempt per protein; returns accepted moves
+    unsigned int sweep();
     
   private:	
 
@@ -119,6 +142,16 @@ namespace voom
     double _T2;
     double _FinalTratio;
 
+    RandomStream * _rng;
+
+    //! Uniform number in [0,1] and integer in [0,n)
+    double _uniform() {
+      return (_rng ? _rng->uniform() : double(rand())/double(RAND_MAX));
+    }
+    unsigned int _randomIndex(unsigned int n) {
+      return (_rng ? _rng->integer(n) : rand()%n);
+    }
+
   };
   
 }; // namespace voom
@@ -0,0 +1,69 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+
+#include<cstdlib>
+#include "MultilevelSolver.h"
+
+namespace voom
+{
+
+  MultilevelSolver::MultilevelSolver(const std::vector<Model*> & models,
+				     const std::vector<Solver*> & solvers,
+				     const std::vector<Prolongation> & prolongations)
+    : _models(models), _solvers(solvers), _P(prolongations)
+  {
+    if( _solvers.size() != _models.size() || _P.size()+1 != _models.size() ) {
+      std::cout << "MultilevelSolver: need one solver per model and one "
+		<< "prolongation between consecutive models." << std::endl;
+      exit(0);
+    }
+    for(int l=0; l<_P.size(); l++) {
+      if( _P[l].cols() != _models[l]->dof() || _P[l].rows() != _models[l+1]->dof() ) {
+	std::cout << "MultilevelSolver: prolongation " << l << " is "
+		  << _P[l].rows() << " x " << _P[l].cols() << " but the models have "
+		  << _models[l+1]->dof() << " and " << _models[l]->dof()
+		  << " dofs." << std::endl;
+	exit(0);
+      }
+    }
+  }
+
+
+
+  int MultilevelSolver::solve() {
+    return solve(0, levels()-1);
+  }
+
+
+
+  int MultilevelSolver::solve(int first, int last) {
+    int status = 0;
+    for(int l=first; l<=last; l++) {
+      if( l > first ) _prolongate(l);
+      std::cout << "MultilevelSolver: level " << l << " of " << levels()
+		<< " (" << _models[l]->dof() << " dofs)" << std::endl;
+      status = _solvers[l]->solve(_models[l]);
+      std::cout << "MultilevelSolver: level " << l << " energy = "
+		<< _solvers[l]->function() << " | status = " << status << std::endl;
+    }
+    return status;
+  }
+
+
+
+  void MultilevelSolver::_prolongate(int l) {
+    Field coarse, fine;
+    coarse.x.resize(_models[l-1]->dof());
+    fine.x.resize(_models[l]->dof());
+    _models[l-1]->getField(coarse);
+    _P[l-1].multiply(&coarse.x[0], &fine.x[0]);
+    _models[l]->putField(fine);
+  }
+
+}; // namespace voom
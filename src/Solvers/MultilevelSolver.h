@@ -0,0 +1,86 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+
+/*!
+  \file MultilevelSolver.h
+
+  \brief Nested iteration: solves a sequence of Models on refined
+  meshes from coarse to fine, starting each from the prolongated
+  solution of the previous one.
+
+*/
+
+#if !defined(__MultilevelSolver_h__)
+#define __MultilevelSolver_h__
+
+#include<iostream>
+#include<vector>
+#include "Model.h"
+#include "Solver.h"
+#include "Multigrid.h"
+
+namespace voom
+{
+
+  /*!  Shells on nested Loop subdivision meshes (icosahedron-1,
+    -2, ... refined by LoopSubdivision) are solved level by level:
+    the coarse problems are cheap, and their solution interpolated to
+    the next mesh is already close to equilibrium, so the fine solver
+    only has to remove the short wavelength error.  The fine solve can
+    in turn use a Multigrid preconditioner over the same hierarchy:
+    \code
+    std::vector<Prolongation> P;  // LoopSubdivision::prolongation().expand(3)
+    Multigrid mg;
+    mg.setHierarchy(P);
+    newton.setPreconditioner(&mg);
+    MultilevelSolver nested(models, solvers, P);
+    nested.solve();
+    \endcode
+
+    models[l] and solvers[l] are ordered coarse to fine and
+    prolongations[l] maps the dofs of models[l] to those of
+    models[l+1] (node by node, in the order of the dof indices).
+  */
+  class MultilevelSolver
+  {
+  public:
+
+    MultilevelSolver(const std::vector<Model*> & models,
+		     const std::vector<Solver*> & solvers,
+		     const std::vector<Prolongation> & prolongations);
+
+    //! Solve every level in turn; returns the status of the finest
+    int solve();
+
+    //! Solve levels first..last only (e.g. to restart on the finest)
+    int solve(int first, int last);
+
+    int levels() const { return _models.size(); }
+
+  private:
+
+    std::vector<Model*> _models;
+    std::vector<Solver*> _solvers;
+    std::vector<Prolongation> _P;
+
+    //! field array used to move a solution between levels
+    struct Field {
+      std::vector<double> x;
+      double & field(int i) { return x[i]; }
+      const double field(int i) const { return x[i]; }
+      const double * fieldData() const { return 0; }
+    };
+
+    //! initialize level l from the field of level l-1
+    void _prolongate(int l);
+  };
+
+}; // namespace voom
+
+#endif // __MultilevelSolver_h__
@@ -0,0 +1,131 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+
+#include<iostream>
+#include<fstream>
+#include<cstdio>
+#include<string>
+
+#include "NewtonSolver.h"
+
+using namespace blitz;
+
+namespace voom
+{
+
+  double NewtonSolver::_lineSearch(double slope) {
+    const double c = 1.0e-4;
+    const double f0 = _f;
+    _x0 = _x;
+
+    double alpha = 1.0;
+    for(int ls=0; ls<_maxLineSearch; ls++, alpha *= 0.5) {
+      _x = _x0 + alpha*_dx;
+      _model->putField( *this );
+      _model->computeAndAssemble( *this, true, false, false );
+      if(_debug) {
+	cout << "Newton:   alpha = " << alpha << " | energy = " << _f << endl;
+      }
+      if( _f <= f0 + c*alpha*slope ) return alpha;
+    }
+
+    // no sufficient decrease; restore the last iterate
+    _x = _x0;
+    _model->putField( *this );
+    _f = f0;
+    return 0.0;
+  }
+
+  int NewtonSolver::_equilibrate() {
+    double initialNorm=-1.0, norm=0.0, tolerance=0.0;
+
+    for(int iter=0; iter<_maxIter; iter++, _iterNo++) {
+      _model->putField( *this );
+      _model->computeAndAssemble( *this, true, true, true );
+
+      norm = sqrt(sum(sqr(_g)));
+      if(initialNorm < 0.0) {
+	initialNorm = norm;
+	tolerance = std::max(_absTol, _tol*initialNorm);
+      }
+      if( norm <= tolerance ) {
+	cout << "Newton converged with residual norm = " << norm
+	     << " and energy = " << _f
+	     << " after " << iter << " iterations." << endl;
+	return 0;
+      }
+
+      // Newton step K dx = -g, solved inexactly (forcing term
+      // decreasing with the residual)
+      _dx = 0.0;
+      Vector_t b(_size);
+      b = -_g;
+      const double linTol = std::min(0.5, std::sqrt(norm))*norm;
+      const int maxLin = ( _maxLinearIter > 0 ? _maxLinearIter : 10*_size );
+      if( _precond ) _precond->setOperator(_K);
+      const int linIter = conjugateGradient(_K, b.data(), _dx.data(),
+					    linTol, maxLin, _precond);
+
+      double slope = sum(_g*_dx);
+      if( slope >= 0.0 ) {
+	// not a descent direction; fall back to steepest descent
+	_dx = -_g;
+	slope = -norm*norm;
+      }
+
+      const double alpha = _lineSearch(slope);
+
+      cout << "Newton: iteration " << setw(4) << iter
+	   << setprecision( 16 )
+	   << " | residual norm = " << norm
+	   << " | energy = " << _f
+	   << " | CG iterations = " << linIter
+	   << " | step = " << alpha << endl;
+
+      if( alpha == 0.0 ) {
+	cout << "Newton: line search failed; residual norm = " << norm
+	     << "." << endl;
+	return 1;
+      }
+    }
+
+    _model->putField( *this );
+    _model->computeAndAssemble( *this, true, true, false );
+    cout << "Newton failed to converge after " << _maxIter << " iterations:"
+	 << endl
+	 << "\t initialNorm = " << initialNorm
+	 << "; norm = " << sqrt(sum(sqr(_g)))
+	 << "; energy = " << _f << endl;
+    return 1;
+  }
+
+  int NewtonSolver::solve(Model * m)
+  {
+    _model = m;
+    if( _size != _model->dof() || _x.size() != _model->dof() ) resize( _model->dof() );
+    assert( _x.size() == _model->dof() );
+
+    _model->getField( *this );
+    _iterNo = 0;
+
+    if( !_load ) return _equilibrate();
+
+    int status = 0;
+    for(int step=1; step<=_loadSteps; step++) {
+      const double lambda = static_cast<double>(step)/_loadSteps;
+      cout << "Newton: load step " << step << " of " << _loadSteps
+	   << " (lambda = " << lambda << ")" << endl;
+      _load->setLoad(lambda);
+      status = _equilibrate();
+      if(status != 0) break;
+    }
+    return status;
+  }
+
+}; // namespace voom
@@ -0,0 +1,170 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+//
+
+/*!
+  \file NewtonSolver.h
+
+  \brief Newton-Raphson solver for static equilibrium of a Finite
+  Element model using the sparse assembled stiffness.
+
+*/
+
+#if !defined(__NewtonSolver_h__)
+#define __NewtonSolver_h__
+
+#include<iostream>
+#include<iomanip>
+#include<cstring>
+#include<string>
+#include<blitz/array.h>
+#include<vector>
+#include "Solver.h"
+#include "SparseMatrix.h"
+
+namespace voom
+{
+
+  /*!  Interface for applying an external load (or any other control
+    parameter) scaled by a load factor lambda in [0,1].  Used by
+    NewtonSolver for load stepping.
+  */
+  class LoadControl
+  {
+  public:
+    virtual ~LoadControl() {}
+    virtual void setLoad(double lambda) = 0;
+  };
+
+  /*!  A concrete class for a globalized Newton-Raphson solver.  Each
+    iteration assembles the sparse stiffness, solves for the Newton
+    step with preconditioned CG (Jacobi, or e.g. a Multigrid V-cycle
+    set by setPreconditioner()), and takes a backtracking
+    (Armijo) line search along it.  If the stiffness is not positive
+    definite along the step the CG solve stops early, which still
+    yields a descent direction.  With a LoadControl the load is
+    applied in equal increments, each solved to equilibrium.
+  */
+
+  class NewtonSolver : public Solver
+  {
+
+  public:
+
+    typedef blitz::Array<double,1> Vector_t;
+
+    NewtonSolver(int n,
+		 double tol=1.0e-8,
+		 double absTol=1.0e-10,
+		 int maxIter=50,
+		 int maxLinearIter=-1,
+		 int maxLineSearch=20,
+		 bool debug=false)
+      : _tol(tol), _absTol(absTol), _maxIter(maxIter),
+	_maxLinearIter(maxLinearIter), _maxLineSearch(maxLineSearch),
+	_debug(debug), _load(0), _loadSteps(1), _precond(0), _iterNo(0)
+    {
+      resize(n);
+    }
+
+    //! destructor
+    virtual ~NewtonSolver() {}
+
+    //! overloading pure virtual function solve()
+    int solve(Model * m);
+
+    //! Apply load through lc in nSteps equal increments
+    void setLoadStepping(LoadControl * lc, int nSteps) {
+      _load = lc;
+      _loadSteps = std::max(nSteps,1);
+    }
+
+    //! Precondition the linear solves with M (0 for Jacobi)
+    /*! M->setOperator() is called with every assembled stiffness. */
+    void setPreconditioner(Preconditioner * M) { _precond = M; }
+
+    double & field(int i) {return _x(i);}
+    double & function() {return _f;}
+    double & gradient(int i) {return _g(i);}
+    double & hessian(int i, int j) {return _K(i,j);}
+
+    const double field(int i) const {return _x(i);}
+    const double function() const {return _f;}
+    const double gradient(int i) const {return _g(i);}
+    const double hessian(int i, int j) const {return _K(i,j);}
+
+    double & hessian(int i) { return hessian(i,i);}
+    const double hessian(int i) const { return hessian(i,i);}
+
+    SparseMatrix * sparseHessian() {return &_K;}
+
+    double * field() { return _x.data();}
+    double * gradient() { return _g.data();}
+
+    void zeroOutData(bool f0, bool f1, bool f2) {
+      if(f0) _f=0.0;
+      if(f1) _g=0.0;
+      if(f2) _K.zero();
+    }
+
+    void resize(size_t sz) {
+      _x.resize(sz);
+      _g.resize(sz);
+      _dx.resize(sz);
+      _x0.resize(sz);
+      _size = sz;
+      _f = 0.0;
+      _x = 0.0;
+      _g = 0.0;
+    }
+
+    int size() const { return _size;}
+
+    int iterationNo() const {return _iterNo;}
+
+  private:
+
+    Vector_t _x;
+    Vector_t _g;
+    Vector_t _dx;
+    Vector_t _x0;
+    SparseMatrix _K;
+
+    double _f;
+    double _tol;
+    double _absTol;
+
+    size_t _size;
+
+    int _maxIter;
+    int _maxLinearIter;
+    int _maxLineSearch;
+
+    bool _debug;
+
+    Model * _model;
+
+    LoadControl * _load;
+    int _loadSteps;
+
+    Preconditioner * _precond;
+
+    int _iterNo;
+
+    //! Newton iterations at fixed load; returns 0 on convergence
+    int _equilibrate();
+
+    //! Backtracking line search along _dx; returns step length (0 on failure)
+    double _lineSearch(double slope);
+
+  };
+
+}; // namespace voom
+
+#endif // __NewtonSolver_h__
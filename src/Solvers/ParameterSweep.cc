@@ -0,0 +1,196 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+
+#include<fstream>
+#include<iomanip>
+#include<cstdio>
+#include<cstdlib>
+#include<ctime>
+#include<algorithm>
+#include<sys/stat.h>
+#include<sys/types.h>
+
+#include "ParameterSweep.h"
+#include "LbfgsbNative.h"
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+namespace voom
+{
+
+  namespace {
+    double wallTime() {
+#ifdef _OPENMP
+      return omp_get_wtime();
+#else
+      return double(std::time(0));
+#endif
+    }
+  }
+
+
+
+  int ParameterSweep::ModelFactory::solve(Model * model, const Point & p,
+					  const std::string & directory,
+					  std::vector<double> & results) {
+    // one log per task, so concurrent solves do not interleave on cout
+    std::ofstream log( (directory + "/lbfgsb.log").c_str() );
+    LbfgsbNative solver(model->dof());
+    solver.setOutputPrefix(directory + "/");
+    if( log ) solver.setOutputStream(log);
+    solver.solve(model);
+    results.push_back( solver.function() );
+    model->print( directory + "/relaxed" );
+    return ( solver.projectedGradientNorm() <= 1.0e-5 ? 0 : 1 );
+  }
+
+
+
+  ParameterSweep::ParameterSweep(ModelFactory * factory,
+				 const std::string & outputRoot, int threads)
+    : _factory(factory), _outputRoot(outputRoot), _threads(threads),
+      _wallTime(0.0), _threadsUsed(1)
+  {}
+
+
+
+  void ParameterSweep::addAxis(const std::string & name,
+			       const std::vector<double> & values) {
+    _names.push_back(name);
+    _axes.push_back(values);
+  }
+
+
+
+  void ParameterSweep::_buildGrid() {
+    _points.clear();
+    if( !_axes.empty() ) {
+      // cartesian product, last axis fastest
+      std::vector<int> k(_axes.size(), 0);
+      bool empty = false;
+      for(int a=0; a<_axes.size(); a++) if( _axes[a].empty() ) empty = true;
+      while( !empty ) {
+	Point p(_axes.size());
+	for(int a=0; a<_axes.size(); a++) p[a] = _axes[a][k[a]];
+	_points.push_back(p);
+	int a = _axes.size()-1;
+	while( a >= 0 && ++k[a] == _axes[a].size() ) { k[a] = 0; a--; }
+	if( a < 0 ) break;
+      }
+    }
+    _points.insert(_points.end(), _extraPoints.begin(), _extraPoints.end());
+  }
+
+
+
+  std::string ParameterSweep::_directory(int k) const {
+    char name[32];
+    sprintf(name, "/task%04d", k);
+    return _outputRoot + name;
+  }
+
+
+
+  int ParameterSweep::run() {
+    _buildGrid();
+    const int N = _points.size();
+    _results.assign(N, std::vector<double>());
+    _status.assign(N, -1);
+    _times.assign(N, 0.0);
+
+    mkdir(_outputRoot.c_str(), 0755);
+    for(int k=0; k<N; k++) mkdir(_directory(k).c_str(), 0755);
+
+    std::cout << "ParameterSweep: " << N << " points";
+    _threadsUsed = 1;
+#ifdef _OPENMP
+    _threadsUsed = ( _threads > 0 ? _threads : omp_get_max_threads() );
+    _threadsUsed = std::max(1, std::min(_threadsUsed, N));
+    std::cout << " on " << _threadsUsed << " threads";
+#endif
+    std::cout << "." << std::endl;
+
+    const double start = wallTime();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,1) num_threads(_threadsUsed)
+#endif
+    for(int k=0; k<N; k++) {
+      const double t0 = wallTime();
+      // Elements copy shape tables out of process-wide caches
+      // (LoopShellShape::shared()), and blitz reference counts are not
+      // atomic, so models are built and freed one at a time; only the
+      // solves run concurrently.
+      Model * model = 0;
+#ifdef _OPENMP
+#pragma omp critical(ParameterSweepBuild)
+#endif
+      model = _factory->create(_points[k]);
+      _status[k] = _factory->solve(model, _points[k], _directory(k), _results[k]);
+#ifdef _OPENMP
+#pragma omp critical(ParameterSweepBuild)
+#endif
+      _factory->destroy(model);
+      _times[k] = wallTime() - t0;
+#ifdef _OPENMP
+#pragma omp critical(ParameterSweepOutput)
+#endif
+      std::cout << "ParameterSweep: point " << k << " finished with status "
+		<< _status[k] << " in " << _times[k] << " s." << std::endl;
+    }
+    _wallTime = wallTime() - start;
+
+    int converged = 0;
+    for(int k=0; k<N; k++) if( _status[k] == 0 ) converged++;
+    printReport(std::cout);
+    printReport(_outputRoot + "/report.dat");
+    return converged;
+  }
+
+
+
+  void ParameterSweep::printReport(const std::string & fileName) const {
+    std::ofstream ofs(fileName.c_str());
+    if (!ofs) {
+      std::cout << "Cannot open output file " << fileName << std::endl;
+      exit(0);
+    }
+    printReport(ofs);
+    ofs.close();
+  }
+
+
+
+  void ParameterSweep::printReport(std::ostream & os) const {
+    const int N = _points.size();
+    os << "# task";
+    for(int a=0; a<_names.size(); a++) os << " " << _names[a];
+    os << " status time results..." << std::endl;
+    double total = 0.0, tmin = 0.0, tmax = 0.0;
+    for(int k=0; k<N; k++) {
+      os << k;
+      for(int a=0; a<_points[k].size(); a++) os << " " << _points[k][a];
+      os << " " << _status[k] << " " << _times[k];
+      for(int r=0; r<_results[k].size(); r++) os << " " << _results[k][r];
+      os << std::endl;
+      total += _times[k];
+      tmin = ( k == 0 ? _times[k] : std::min(tmin, _times[k]) );
+      tmax = std::max(tmax, _times[k]);
+    }
+    os << "# points " << N << " | threads " << _threadsUsed
+       << " | wall time " << _wallTime << " s"
+       << " | task time total " << total
+       << " mean " << ( N > 0 ? total/N : 0.0 )
+       << " min " << tmin << " max " << tmax
+       << " | speedup " << ( _wallTime > 0.0 ? total/_wallTime : 0.0 )
+       << std::endl;
+  }
+
+}; // namespace voom
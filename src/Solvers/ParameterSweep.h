@@ -0,0 +1,124 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+
+/*!
+  \file ParameterSweep.h
+
+  \brief Runs independent Model solves over a grid of parameters
+  concurrently, one solve per thread.
+
+*/
+
+#if !defined(__ParameterSweep_h__)
+#define __ParameterSweep_h__
+
+#include<iostream>
+#include<string>
+#include<vector>
+#include "Model.h"
+
+namespace voom
+{
+
+  /*!  A parameter sweep (FVK numbers, temperatures, material
+    constants, ...) in which every grid point is an independent
+    problem: a ModelFactory builds a Model for the point, solves it
+    and writes its output into a directory of its own.  Points are
+    handed out dynamically to a pool of OpenMP threads, so a node
+    with many cores runs many solves at once.  Each solve runs on one
+    thread (nested parallelism is left as configured by the user, off
+    by default), which gives far better throughput than parallelizing
+    a single small solve.
+
+    Factories must not modify state shared between grid points;
+    everything a point needs (nodes, bodies, materials, model,
+    solver) is built in create() and freed in destroy().  create()
+    and destroy() are serialized, since models may share cached
+    tables (e.g. shape functions) whose reference counts are not
+    thread safe; solve() runs concurrently and must only touch its
+    own model and write to its own directory.
+  */
+  class ParameterSweep
+  {
+  public:
+
+    //! Parameter values of one grid point, in the order of the axes
+    typedef std::vector<double> Point;
+
+    class ModelFactory
+    {
+    public:
+      virtual ~ModelFactory() {}
+
+      //! Build the model for parameters p (one call at a time)
+      virtual Model * create(const Point & p) = 0;
+
+      //! Solve the model; write output under directory and put any
+      //! scalar results of interest into results.  Returns a status.
+      /*! Called concurrently.  The default relaxes with LbfgsbNative,
+	writing its iteration table to directory/lbfgsb.log, and
+	records the energy. */
+      virtual int solve(Model * model, const Point & p,
+			const std::string & directory,
+			std::vector<double> & results);
+
+      //! Free everything create() allocated
+      virtual void destroy(Model * model) = 0;
+    };
+
+    /*! Output of grid point k goes to directory
+      outputRoot/task<k>; threads <= 0 uses all available. */
+    ParameterSweep(ModelFactory * factory,
+		   const std::string & outputRoot="sweep", int threads=0);
+
+    //! Add an axis; the grid is the cartesian product of all axes
+    void addAxis(const std::string & name, const std::vector<double> & values);
+
+    //! Add a single point (values for all axes, in order)
+    void addPoint(const Point & p) { _extraPoints.push_back(p); }
+
+    //! Solve all points; returns the number that returned status 0
+    int run();
+
+    //! Table of points, status, wall time and results, with totals
+    void printReport(const std::string & fileName) const;
+    void printReport(std::ostream & os) const;
+
+    int numberOfPoints() const { return _points.size(); }
+    const Point & point(int k) const { return _points[k]; }
+    const std::vector<double> & results(int k) const { return _results[k]; }
+    int status(int k) const { return _status[k]; }
+    double time(int k) const { return _times[k]; }
+
+  private:
+
+    ModelFactory * _factory;
+    std::string _outputRoot;
+    int _threads;
+
+    std::vector<std::string> _names;
+    std::vector< std::vector<double> > _axes;
+    std::vector<Point> _extraPoints;
+
+    //! the grid and per-point outcome
+    std::vector<Point> _points;
+    std::vector< std::vector<double> > _results;
+    std::vector<int> _status;
+    std::vector<double> _times;
+    double _wallTime;
+    int _threadsUsed;
+
+    void _buildGrid();
+
+    std::string _directory(int k) const;
+  };
+
+}; // namespace voom
+
+#endif // __ParameterSweep_h__
@@ -0,0 +1,169 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+
+#include <fstream>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include "ReplicaExchangeProtein.h"
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+namespace voom {
+
+  ReplicaExchangeProtein::ReplicaExchangeProtein(vector<ProteinNode* > & Proteins,
+						 ProteinPotential * Mat,
+						 double SearchR,
+						 map<DeformationNode<3> *, vector<DeformationNode<3> *> > & PossibleHosts,
+						 const vector<double> & Temperatures,
+						 unsigned long long Seed,
+						 double Pressure,
+						 double Skin):
+    _proteins(Proteins), _temperatures(Temperatures), _rng(Seed, 0)
+  {
+    const int K = _temperatures.size();
+    if(K < 1) {
+      cout << "ReplicaExchangeProtein: empty temperature ladder." << endl;
+      exit(0);
+    }
+    std::sort(_temperatures.begin(), _temperatures.end());
+
+    for(int k = 0; k < K; k++) {
+      Replica * R = new Replica;
+      for(uint i = 0; i < Proteins.size(); i++)
+	R->proteins.push_back( new ProteinNode(Proteins[i]->getHost(), Proteins[i]->getLength()) );
+      R->body = new ProteinBody(R->proteins, Mat, SearchR, Pressure, Skin);
+      R->mc = new MontecarloProtein(R->proteins, R->body, PossibleHosts, 0, 0);
+      R->rng.seed(Seed, k+1);
+      R->mc->setRandomStream(&R->rng);
+      R->mc->setTemperature(_temperatures[k]);
+      R->accepted = 0;
+      _replicas.push_back(R);
+      _atTemperature.push_back(k);
+    }
+    _attempts.assign(std::max(K-1,0), 0);
+    _swaps.assign(std::max(K-1,0), 0);
+
+    _bestEnergy = _replicas[0]->mc->resetEnergy();
+    for(uint i = 0; i < Proteins.size(); i++) _bestHosts.push_back(Proteins[i]->getHost());
+  }
+
+
+
+  ReplicaExchangeProtein::~ReplicaExchangeProtein()
+  {
+    for(uint k = 0; k < _replicas.size(); k++) {
+      delete _replicas[k]->mc;
+      delete _replicas[k]->body;
+      for(uint i = 0; i < _replicas[k]->proteins.size(); i++)
+	delete _replicas[k]->proteins[i];
+      delete _replicas[k];
+    }
+  }
+
+
+
+  void ReplicaExchangeProtein::solve(unsigned int NSweeps, unsigned int SwapInterval,
+				     unsigned int ComputeNeighInterval, double Rsearch)
+  {
+    const int K = _replicas.size();
+    SwapInterval = std::max(SwapInterval, 1u);
+    ComputeNeighInterval = std::max(ComputeNeighInterval, 1u);
+
+    for(int r = 0; r < K; r++) _replicas[r]->mc->resetEnergy();
+
+    unsigned int sweep = 0;
+    int parity = 0;
+    while(sweep < NSweeps)
+    {
+      const unsigned int block = std::min(SwapInterval, NSweeps - sweep);
+
+      // Replicas are independent between swaps
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,1) default(shared)
+#endif
+      for(int r = 0; r < K; r++) {
+	Replica * R = _replicas[r];
+	for(unsigned int s = 1; s <= block; s++) {
+	  R->accepted += R->mc->sweep();
+	  if((sweep + s)%ComputeNeighInterval == 0) {
+	    R->body->recomputeNeighbors(Rsearch);
+	    R->mc->resetEnergy();
+	  }
+	}
+      }
+      sweep += block;
+
+      // Keep the best configuration seen at the lowest temperature
+      Replica * cold = _replicas[_atTemperature[0]];
+      if(cold->mc->energy() < _bestEnergy) {
+	_bestEnergy = cold->mc->energy();
+	for(uint i = 0; i < _bestHosts.size(); i++) _bestHosts[i] = cold->proteins[i]->getHost();
+      }
+
+      _attemptSwaps(parity);
+      parity = 1 - parity;
+
+      cout << "Replica exchange sweep = " << sweep
+	   << " | E(T0) = " << _replicas[_atTemperature[0]]->mc->energy()
+	   << " | best = " << _bestEnergy << endl;
+    }
+
+    // Return the best low temperature configuration
+    for(uint i = 0; i < _proteins.size(); i++) _proteins[i]->setHost(_bestHosts[i]);
+
+    cout << "ReplicaExchangeProtein done :) " << endl;
+  }
+
+
+
+  void ReplicaExchangeProtein::_attemptSwaps(int parity)
+  {
+    for(int k = parity; k+1 < int(_temperatures.size()); k += 2) {
+      Replica * A = _replicas[_atTemperature[k]];
+      Replica * B = _replicas[_atTemperature[k+1]];
+      const double delta = (1.0/_temperatures[k] - 1.0/_temperatures[k+1])*
+	(A->mc->energy() - B->mc->energy());
+
+      _attempts[k]++;
+      if(delta >= 0.0 || _rng.uniform() < exp(delta)) {
+	_swaps[k]++;
+	std::swap(_atTemperature[k], _atTemperature[k+1]);
+	A->mc->setTemperature(_temperatures[k+1]);
+	B->mc->setTemperature(_temperatures[k]);
+      }
+    }
+  }
+
+
+
+  void ReplicaExchangeProtein::printSwapReport(const string & FileName) const
+  {
+    ofstream ofs(FileName.c_str());
+    if (!ofs) {
+      std::cout << "Cannot open output file " << FileName << std::endl;
+      exit(0);
+    }
+    ofs << "# T_k T_k+1 attempts accepted ratio" << endl;
+    for(uint k = 0; k < _attempts.size(); k++) {
+      ofs << _temperatures[k] << " " << _temperatures[k+1] << " "
+	  << _attempts[k] << " " << _swaps[k] << " "
+	  << (_attempts[k] > 0 ? double(_swaps[k])/double(_attempts[k]) : 0.0) << endl;
+    }
+    ofs << "# T replica accepted_moves" << endl;
+    for(uint k = 0; k < _atTemperature.size(); k++) {
+      ofs << "# " << _temperatures[k] << " " << _atTemperature[k] << " "
+	  << _replicas[_atTemperature[k]]->accepted << endl;
+    }
+    ofs.close();
+  }
+
+}; // namespace voom
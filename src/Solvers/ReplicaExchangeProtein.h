@@ -0,0 +1,115 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+
+/*!
+  \file ReplicaExchangeProtein.h
+
+  \brief Parallel tempering (replica exchange) for protein lattice
+  configurations, built on MontecarloProtein.
+
+*/
+
+#if !defined(__ReplicaExchangeProtein_h__)
+#define __ReplicaExchangeProtein_h__
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+
+#include "ProteinBody.h"
+#include "MontecarloProtein.h"
+#include "RandomStream.h"
+
+using namespace std;
+
+namespace voom
+{
+
+  /*!  Runs K copies (replicas) of a protein system, each with its own
+    ProteinBody, MontecarloProtein and RandomStream, at the
+    temperatures of a ladder T_0 < T_1 < ... < T_{K-1}.  Replicas do
+    Metropolis sweeps concurrently (one OpenMP thread per replica);
+    every swapInterval sweeps, replicas at neighboring temperatures
+    attempt to exchange temperatures with probability
+    min(1, exp[(1/T_k - 1/T_{k+1})(E_k - E_{k+1})]), alternating even
+    and odd pairs.  Hot replicas cross energy barriers and hand their
+    configurations down the ladder.
+
+    The potential and the PossibleHosts map are shared read-only, so
+    the potential's equilibrium parameter is not varied (MontecarloProtein
+    method 0 moves only).  At the end the lowest energy configuration
+    visited at T_0 is copied into the original proteins.
+  */
+  class ReplicaExchangeProtein
+  {
+  public:
+
+    ReplicaExchangeProtein(vector<ProteinNode* > & Proteins,
+			   ProteinPotential * Mat,
+			   double SearchR,
+			   map<DeformationNode<3> *, vector<DeformationNode<3> *> > & PossibleHosts,
+			   const vector<double> & Temperatures,
+			   unsigned long long Seed = 0,
+			   double Pressure = 0.0,
+			   double Skin = 0.0);
+
+    //! destructor
+    virtual ~ReplicaExchangeProtein();
+
+    //! Run NSweeps sweeps per replica, attempting swaps every SwapInterval
+    void solve(unsigned int NSweeps, unsigned int SwapInterval,
+	       unsigned int ComputeNeighInterval, double Rsearch);
+
+    //! Write swap attempts and acceptance ratios for each pair of temperatures
+    void printSwapReport(const string & FileName) const;
+
+    int numberOfReplicas() const { return _replicas.size(); }
+
+    //! Energy of the replica currently at temperature index k
+    double energy(int k) const { return _replicas[_atTemperature[k]]->mc->energy(); }
+
+    //! Lowest energy visited at the lowest temperature
+    double bestEnergy() const { return _bestEnergy; }
+
+  private:
+
+    struct Replica {
+      vector<ProteinNode* > proteins;
+      ProteinBody * body;
+      MontecarloProtein * mc;
+      RandomStream rng;
+      unsigned long accepted;
+    };
+
+    vector<ProteinNode* > & _proteins;
+    vector<Replica *> _replicas;
+    vector<double> _temperatures;
+
+    //! replica currently at each temperature index
+    vector<int> _atTemperature;
+
+    //! swap statistics for temperature pairs (k,k+1)
+    vector<unsigned long> _attempts;
+    vector<unsigned long> _swaps;
+
+    //! stream for swap decisions
+    RandomStream _rng;
+
+    double _bestEnergy;
+    vector<DeformationNode<3> *> _bestHosts;
+
+    //! Attempt swaps of pairs (k,k+1) with k of the given parity
+    void _attemptSwaps(int parity);
+  };
+
+}; // namespace voom
+
+#endif // __ReplicaExchangeProtein_h__
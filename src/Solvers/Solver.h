@@ -31,7 +31,10 @@
 
 #include<blitz/array.h>
 #include<vector>
+#include<algorithm>
+#include<cmath>
 #include "Model.h"
+#include "SparseMatrix.h"
 
 namespace voom
 {
@@ -67,10 +70,68 @@ public:
   virtual double & hessian(int i) { return hessian(i,i);}
   virtual const double hessian(int i) const { return hessian(i,i);}
 
+  //! Sparse storage for the full stiffness, if the solver has one.
+  /*! When non-null, Model::computeAndAssemble() assembles element
+    stiffness into this matrix instead of the nodal diagonal.
+  */
+  virtual SparseMatrix * sparseHessian() { return 0; }
+
+  //! Contiguous field and gradient arrays, if the solver has them
+  /*! When these are the model's bound dof storage
+    (Model::bindStorage()), getField/putField and the gradient copy
+    in Model::computeAndAssemble() are skipped.
+  */
+  virtual const double * fieldData() const { return 0; }
+  virtual const double * gradientData() const { return 0; }
+
   virtual void zeroOutData(bool f0, bool f1, bool f2) = 0;
 
   virtual void resize(size_t sz) = 0;
 
+protected:
+
+  //! Make x and g views of the model's bound field and force storage
+  /*! Returns false (and leaves x and g alone) if the model has no
+    bound storage (Model::bindStorage()).  A solver iterating on these
+    views makes getField/putField and the gradient copy no-ops.
+  */
+  static bool shareModelStorage(Model * model, blitz::Array<double,1> & x,
+				blitz::Array<double,1> & g) {
+    if( !model->storageBound() ) return false;
+    const int n = model->dof();
+    x.reference( blitz::Array<double,1>(model->fieldData(), blitz::shape(n), blitz::neverDeleteData) );
+    g.reference( blitz::Array<double,1>(model->forceData(), blitz::shape(n), blitz::neverDeleteData) );
+    return true;
+  }
+
+  //! Inverse of an assembled diagonal stiffness h, for preconditioners
+  //! and masses
+  /*! inv(i) = 1/|h(i)| where |h(i)| is above 1e-8 of the largest
+    entry.  Dof with a zero or missing entry (no nodal stiffness, as
+    for gel and protein bodies) get the inverse of the mean of the
+    other entries rather than a huge value.  Returns false, leaving
+    inv alone, if h has no positive entry at all.
+  */
+  static bool inverseDiagonal(const blitz::Array<double,1> & h,
+			      blitz::Array<double,1> & inv) {
+    const int n = h.size();
+    double hmax = 0.0;
+    for(int i=0; i<n; i++) hmax = std::max(hmax, std::abs(h(i)));
+    if( !(hmax > 0.0) ) return false;
+    const double floor = 1.0e-8*hmax;
+    double sum = 0.0;
+    int count = 0;
+    for(int i=0; i<n; i++)
+      if( std::abs(h(i)) > floor ) { sum += std::abs(h(i)); count++; }
+    const double fill = count/sum;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(int i=0; i<n; i++)
+      inv(i) = ( std::abs(h(i)) > floor ? 1.0/std::abs(h(i)) : fill );
+    return true;
+  }
+
 };
 
 // struct for solver type storage
@@ -96,6 +157,9 @@ struct Storage : public Solver {
   double * field() {return _x.data();}
   double * gradient() {return _DE.data();}
 
+  const double * fieldData() const {return _x.data();}
+  const double * gradientData() const {return _DE.data();}
+
   void zeroOutData(bool f0, bool f1, bool f2) {
     if(f0) _E=0.0;
     if(f1) _DE=0.0;
@@ -117,5 +181,53 @@ struct Storage : public Solver {
 
 };
 
+// struct for solver type storage with sparse stiffness
+struct SparseStorage : public Solver {
+
+  double _E;
+  blitz::Array<double,1> _x;
+  blitz::Array<double,1> _DE;
+  SparseMatrix _DDE;
+
+  double & field(int i) {return _x(i);}
+  double & function() {return _E;}
+  double & gradient(int i) {return _DE(i);}
+  double & hessian(int i, int j) {return _DDE(i,j);}
+  double & hessian(int i) {return _DDE(i,i);}
+
+  double const field(int i) const {return _x(i);}
+  double const function() const {return _E;}
+  double const gradient(int i) const {return _DE(i);}
+  double const hessian(int i, int j) const {return _DDE(i,j);}
+  double const hessian(int i) const {return _DDE(i,i);}
+
+  double * field() {return _x.data();}
+  double * gradient() {return _DE.data();}
+
+  const double * fieldData() const {return _x.data();}
+  const double * gradientData() const {return _DE.data();}
+
+  SparseMatrix * sparseHessian() {return &_DDE;}
+
+  void zeroOutData(bool f0, bool f1, bool f2) {
+    if(f0) _E=0.0;
+    if(f1) _DE=0.0;
+    if(f2) _DDE.zero();
+  }
+  
+  // the stiffness pattern is set by the model on first assembly
+  void resize(size_t sz) { 
+    _x.resize(sz); 
+    _DE.resize(sz); 
+    _x = 0.0;
+    _DE = 0.0;
+  }
+
+  int size() const {return _x.size();}
+
+  int solve(Model * m) {return 0;} 
+
+};
+
 }; // namespace voom
 #endif // __Solver_h__
@@ -0,0 +1,154 @@
+#include <vector>
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+#include "Node.h"
+#include "Body.h"
+#include "Model.h"
+#include "ContinuationSolver.h"
+
+using namespace std;
+using namespace voom;
+
+typedef DeformationNode<3> Node_t;
+
+// Chain of nodes, each tied by a linear spring to an anchor that
+// moves with the load parameter, and to its neighbor by a quartic
+// spring.  The energy is convex, so every load has one equilibrium.
+class LoadedChain : public Body
+{
+public:
+  LoadedChain(const vector<Node_t*> & nodes, double k, double c)
+    : _chain(nodes), _k(k), _c(c), _load(0.0) {
+    for(int a=0; a<_chain.size(); a++) addNode(_chain[a]);
+  }
+
+  void setLoad(double load) { _load = load; }
+
+  //! Anchor of dof i of node a at the current load
+  double anchor(int a, int i) const {
+    const double X[3] = {1.0*a, 0.0, 0.0};
+    const double w[3] = {a/(_chain.size()-1.0), 0.5*std::sin(1.0*a), 0.0};
+    return X[i] + _load*w[i];
+  }
+
+  void compute(bool f0, bool f1, bool f2) {
+    if(f0) _energy = 0.0;
+    for(int a=0; a<_chain.size(); a++) {
+      for(int i=0; i<3; i++) {
+	const double u = _chain[a]->getPoint(i) - anchor(a,i);
+	if(f0) _energy += 0.5*_k*u*u;
+	if(f1) _chain[a]->addForce(i, _k*u);
+      }
+      if(a+1 == _chain.size()) continue;
+      for(int i=0; i<3; i++) {
+	const double d = _chain[a+1]->getPoint(i) - _chain[a]->getPoint(i) - (i == 0 ? 1.0 : 0.0);
+	if(f0) _energy += 0.25*_c*d*d*d*d;
+	if(f1) {
+	  _chain[a]->addForce(i, -_c*d*d*d);
+	  _chain[a+1]->addForce(i, _c*d*d*d);
+	}
+      }
+    }
+  }
+
+  void printParaview(std::string name) const {}
+
+private:
+  vector<Node_t*> _chain;
+  double _k, _c, _load;
+};
+
+class ChainLoad : public ContinuationSolver::Parameter
+{
+public:
+  ChainLoad(LoadedChain * chain) : _chain(chain) {}
+  void apply(double lambda) { _chain->setLoad(lambda); }
+private:
+  LoadedChain * _chain;
+};
+
+// Records the load and the gradient norm of every converged step
+class RecordingSolver : public ContinuationSolver
+{
+public:
+  RecordingSolver(Parameter * p, int maxIterations, Predictor predictor)
+    : ContinuationSolver(p, 5, 1.0e-6, maxIterations, predictor) {}
+
+  void stepCompleted(double lambda, int step, int iterations) {
+    double gnorm = 0.0;
+    for(int i=0; i<size(); i++) gnorm = std::max(gnorm, std::abs(gradient(i)));
+    lambdas.push_back(lambda);
+    gradientNorms.push_back(gnorm);
+  }
+
+  vector<double> lambdas, gradientNorms;
+};
+
+// Sweep the load from 0 to 3 with the secant and tangent predictors.
+// The first step is the whole sweep, which the corrector cannot do
+// within its iteration limit, so it must be bisected.  Every step
+// must converge, and the final state must match a single solve at
+// the final load.
+int main()
+{
+  const int nNodes = 8;
+  const double lambda1 = 3.0;
+  const double gtol = 1.0e-6;
+  const ContinuationSolver::Predictor predictors[3] =
+    {ContinuationSolver::NONE, ContinuationSolver::SECANT, ContinuationSolver::TANGENT};
+  vector<double> result[3];
+
+  bool passed = true;
+  for(int run=0; run<3; run++) {
+    vector<Node_t*> chain;
+    Model::NodeContainer nodes;
+    for(int a=0; a<nNodes; a++) {
+      NodeBase::DofIndexMap idx(3);
+      for(int i=0; i<3; i++) idx[i] = 3*a+i;
+      Node_t::Point X;
+      X = 1.0*a, 0.0, 0.0;
+      chain.push_back(new Node_t(a, idx, X));
+      nodes.push_back(chain.back());
+    }
+    LoadedChain body(chain, 1.0, 1.0);
+    ChainLoad load(&body);
+
+    Model::BodyContainer bodies(1, &body);
+    Model model(bodies, nodes);
+
+    // run 0 is the reference: one step with a generous iteration limit
+    RecordingSolver solver(&load, (run == 0 ? 1000 : 16), predictors[run]);
+    solver.setStepControl(lambda1, 1.0e-3, lambda1, 10);
+    const int steps = solver.solve(&model, 0.0, lambda1);
+
+    cout << "predictor " << run << ": " << steps << " steps at loads";
+    for(int s=0; s<solver.lambdas.size(); s++) cout << " " << solver.lambdas[s];
+    cout << endl;
+
+    passed = passed && steps > 0 && solver.lambdas.back() == lambda1;
+    for(int s=0; s<solver.gradientNorms.size(); s++)
+      passed = passed && solver.gradientNorms[s] <= gtol;
+    if(run == 0) passed = passed && steps == 1;
+    else passed = passed && steps > 1 && solver.lambdas[1] <= 0.5*lambda1;
+
+    for(int a=0; a<nNodes; a++)
+      for(int i=0; i<3; i++) result[run].push_back(chain[a]->getPoint(i));
+    for(int a=0; a<nNodes; a++) delete chain[a];
+  }
+
+  double error = 0.0;
+  for(int run=1; run<3; run++)
+    for(int j=0; j<result[0].size(); j++)
+      error = std::max(error, std::abs(result[run][j]-result[0][j]));
+  cout << "max difference from a single solve = " << error << endl;
+  passed = passed && error < 1.0e-5;
+
+  if(passed) {
+    cout << "ContinuationSolver test PASSED!" << endl;
+    return 0;
+  }
+  cout << "ContinuationSolver test FAILED!" << endl;
+  return 1;
+}
@@ -0,0 +1,112 @@
+#include <vector>
+#include <iostream>
+#include <cmath>
+
+#include "Node.h"
+#include "Body.h"
+#include "Model.h"
+#include "ViscousRelaxation.h"
+#include "FireRelaxation.h"
+
+using namespace std;
+using namespace voom;
+
+typedef DeformationNode<3> Node_t;
+
+// Chain of nodes, each tied to an anchor by a linear spring and to
+// its neighbor by a quartic one.  It assembles no nodal stiffness,
+// like the gel and protein bodies.
+class SpringChain : public Body
+{
+public:
+  SpringChain(const vector<Node_t*> & nodes, double k, double c)
+    : _chain(nodes), _k(k), _c(c) {
+    for(int a=0; a<_chain.size(); a++) {
+      _anchors.push_back(_chain[a]->point());
+      addNode(_chain[a]);
+    }
+  }
+
+  void compute(bool f0, bool f1, bool f2) {
+    if(f0) _energy = 0.0;
+    for(int a=0; a<_chain.size(); a++) {
+      for(int i=0; i<3; i++) {
+	const double u = _chain[a]->getPoint(i) - _anchors[a](i);
+	if(f0) _energy += 0.5*_k*u*u;
+	if(f1) _chain[a]->addForce(i, _k*u);
+      }
+      if(a+1 == _chain.size()) continue;
+      for(int i=0; i<3; i++) {
+	const double d = _chain[a+1]->getPoint(i) - _chain[a]->getPoint(i) - 1.0;
+	if(f0) _energy += 0.25*_c*d*d*d*d;
+	if(f1) {
+	  _chain[a]->addForce(i, -_c*d*d*d);
+	  _chain[a+1]->addForce(i, _c*d*d*d);
+	}
+      }
+    }
+  }
+
+  void printParaview(std::string name) const {}
+
+private:
+  vector<Node_t*> _chain;
+  vector<Node_t::Point> _anchors;
+  double _k, _c;
+};
+
+// Relax the same chain with ViscousRelaxation, FIRE with unit masses
+// and FIRE with stiffness masses (which must fall back to unit masses
+// since the body assembles no stiffness) and compare the minimizers.
+int main()
+{
+  const int nNodes = 8;
+  vector<double> result[3];
+
+  for(int run=0; run<3; run++) {
+    vector<Node_t*> chain;
+    Model::NodeContainer nodes;
+    for(int a=0; a<nNodes; a++) {
+      NodeBase::DofIndexMap idx(3);
+      for(int i=0; i<3; i++) idx[i] = 3*a+i;
+      Node_t::Point X;
+      X = 1.0*a, 0.0, 0.0;
+      chain.push_back(new Node_t(a, idx, X));
+      nodes.push_back(chain.back());
+    }
+    SpringChain body(chain, 1.0, 1.0);
+
+    // start from a perturbed configuration
+    for(int a=0; a<nNodes; a++)
+      for(int i=0; i<3; i++) chain[a]->addPoint(i, 0.3*std::sin(1.0+a+2.0*i));
+
+    Model::BodyContainer bodies(1, &body);
+    Model model(bodies, nodes);
+
+    if(run == 0) {
+      ViscousRelaxation vr(model.dof(), 0.1, 1.0e-12, 1.0e-12, 100000, 100000);
+      vr.solve(&model);
+    } else {
+      FireRelaxation fire(model.dof(), 0.1, 1.0e-12, 1.0e-12, 100000, 100000);
+      if(run == 2) fire.setMasses(true);
+      fire.solve(&model);
+    }
+
+    for(int a=0; a<nNodes; a++)
+      for(int i=0; i<3; i++) result[run].push_back(chain[a]->getPoint(i));
+    for(int a=0; a<nNodes; a++) delete chain[a];
+  }
+
+  double error = 0.0;
+  for(int run=1; run<3; run++)
+    for(int j=0; j<result[0].size(); j++)
+      error = std::max(error, std::abs(result[run][j]-result[0][j]));
+  cout << "max difference from ViscousRelaxation = " << error << endl;
+
+  if(error < 1.0e-8) {
+    cout << "FireRelaxation test PASSED!" << endl;
+    return 0;
+  }
+  cout << "FireRelaxation test FAILED!" << endl;
+  return 1;
+}
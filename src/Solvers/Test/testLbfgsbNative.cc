@@ -0,0 +1,117 @@
+#include <vector>
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+#include "Node.h"
+#include "Body.h"
+#include "Model.h"
+#include "LbfgsbNative.h"
+
+using namespace std;
+using namespace voom;
+
+typedef DeformationNode<3> Node_t;
+
+// Uncoupled springs E = sum_j k_j/2 (x_j - c_j)^2 with stiffness
+// ranging over four decades.  It assembles its nodal (diagonal)
+// stiffness, which is exact here.
+class ScaledSprings : public Body
+{
+public:
+  ScaledSprings(const vector<Node_t*> & nodes, const vector<double> & k,
+		const vector<double> & c)
+    : _springs(nodes), _k(k), _c(c) {
+    for(int a=0; a<_springs.size(); a++) addNode(_springs[a]);
+  }
+
+  void compute(bool f0, bool f1, bool f2) {
+    if(f0) _energy = 0.0;
+    for(int a=0; a<_springs.size(); a++) {
+      for(int i=0; i<3; i++) {
+	const int j = 3*a+i;
+	const double u = _springs[a]->getPoint(i) - _c[j];
+	if(f0) _energy += 0.5*_k[j]*u*u;
+	if(f1) _springs[a]->addForce(i, _k[j]*u);
+	if(f2) _springs[a]->addStiffness(i, _k[j]);
+      }
+    }
+  }
+
+  void printParaview(std::string name) const {}
+
+private:
+  vector<Node_t*> _springs;
+  vector<double> _k, _c;
+};
+
+// Minimize with bounds |x_j| <= 0.5 on most dof, so that many
+// targets c_j lie outside and their bounds are active.  The minimizer
+// is c_j clipped to the bounds.  Run without and with the diagonal
+// preconditioner and compare iteration counts.
+int main()
+{
+  const int nNodes = 8;
+  const int n = 3*nNodes;
+  const double pgtol = 1.0e-4;
+
+  vector<double> k(n), c(n), exact(n);
+  LbfgsbNative::IntArray nbd(n);
+  LbfgsbNative::Vector_t l(n), u(n);
+  int active = 0;
+  for(int j=0; j<n; j++) {
+    k[j] = std::pow(10.0, 4.0*j/(n-1));
+    c[j] = std::sin(1.0 + 0.7*j);
+    // every fourth dof is free
+    nbd(j) = ( j%4 == 3 ? 0 : 2 );
+    l(j) = -0.5;
+    u(j) = 0.5;
+    exact[j] = c[j];
+    if( nbd(j) == 2 ) exact[j] = std::min(std::max(c[j], l(j)), u(j));
+    if( exact[j] != c[j] ) active++;
+  }
+
+  int iterations[2];
+  bool passed = ( active > 0 );
+  for(int run=0; run<2; run++) {
+    vector<Node_t*> springs;
+    Model::NodeContainer nodes;
+    for(int a=0; a<nNodes; a++) {
+      NodeBase::DofIndexMap idx(3);
+      for(int i=0; i<3; i++) idx[i] = 3*a+i;
+      Node_t::Point X(0.0);
+      springs.push_back(new Node_t(a, idx, X));
+      nodes.push_back(springs.back());
+    }
+    ScaledSprings body(springs, k, c);
+
+    Model::BodyContainer bodies(1, &body);
+    Model model(bodies, nodes);
+
+    LbfgsbNative solver(model.dof(), 5, 1.0e+1, pgtol, 0, 10000);
+    solver.setBounds(nbd, l, u);
+    if(run == 1) solver.setPreconditioner(true);
+    solver.solve(&model);
+    iterations[run] = solver.iterationNo();
+
+    double error = 0.0;
+    for(int a=0; a<nNodes; a++)
+      for(int i=0; i<3; i++)
+	error = std::max(error, std::abs(springs[a]->getPoint(i) - exact[3*a+i]));
+    cout << (run == 1 ? "preconditioned: " : "plain:          ")
+	 << iterations[run] << " iterations, |proj g| = "
+	 << solver.projectedGradientNorm() << ", max error = " << error << endl;
+
+    // k_j >= 1, so the error on a free dof is at most |proj g|
+    passed = passed && solver.projectedGradientNorm() <= pgtol && error <= pgtol;
+    for(int a=0; a<nNodes; a++) delete springs[a];
+  }
+  passed = passed && iterations[1] < iterations[0];
+
+  if(passed) {
+    cout << "LbfgsbNative test PASSED!" << endl;
+    return 0;
+  }
+  cout << "LbfgsbNative test FAILED!" << endl;
+  return 1;
+}
@@ -55,13 +55,14 @@ int cg_descent /*  return  0 (convergence tolerance satisfied)
     double            *x , /* input: starting guess, output: the solution */
     int              dim , /* problem dimension (also denoted n) */
     double    (*cg_value)  /* user provided routine to return the function */
-               (double *), /* value cg_value(x) at x */
-    void       (*cg_grad)  /* user provided routine cg_grad (g, x), g is*/
-     (double *, double *), /* the gradient at x*/
+               (double *, void *), /* value cg_value(x, User) at x */
+    void       (*cg_grad)  /* user provided routine cg_grad (g, x, User), g is*/
+     (double *, double *, void *), /* the gradient at x*/
     double         *work , /* working array with at least 4n elements */
     double          step , /* initial step for line search
                               ignored unless Step != 0 in cg_descent_c.parm */
-    cg_stats      *Stats   /* structure with statistics (see cg_descent.h) */
+    cg_stats      *Stats , /* structure with statistics (see cg_descent.h) */
+    void           *User   /* passed unchanged to cg_value and cg_grad */
 )
 {
     double  *d, *g, *xtemp, *gtemp, *d1, *d2, *d3, *d4,
@@ -95,6 +96,7 @@ int cg_descent /*  return  0 (convergence tolerance satisfied)
 
     status = cg_descent_init (dim, &Parm) ;
     if ( status ) goto Exit ;
+    Parm.User = User ;
     maxit = Parm.maxit ;
 
     if ( Parm.Step ) alpha = step ;
@@ -105,9 +107,9 @@ int cg_descent /*  return  0 (convergence tolerance satisfied)
 
 /* initial function and gradient evaluations, initial direction */
 
-    f = cg_value (x) ;
+    f = cg_value (x, Parm.User) ;
     Parm.nf++ ;
-    cg_grad (g, x) ;
+    cg_grad (g, x, Parm.User) ;
     Parm.ng++ ;
     Parm.f0 = f + f ;
     gnorm = zero ;
@@ -211,7 +213,7 @@ int cg_descent /*  return  0 (convergence tolerance satisfied)
             {
                 talpha = Parm.psi1*alpha ;
                 cg_step (xtemp, x, d, talpha, n) ;
-                ftemp = cg_value (xtemp) ;
+                ftemp = cg_value (xtemp, Parm.User) ;
                 Parm.nf++ ;
                 if ( ftemp < f )
                 {
@@ -1006,16 +1008,13 @@ double cg_dot
     int     n  /* length of vectors */
 )
 {
-    int i, n5 ;
+    int i ;
     double t ;
     t = 0. ;
-    n5 = n % 5 ;
-    for (i = 0; i < n5; i++) t += x [i]*y [i] ;
-    for (; i < n; i += 5)
-    {
-        t += x [i]*y[i] + x [i+1]*y [i+1] + x [i+2]*y [i+2]
-           + x [i+3]*y [i+3] + x [i+4]*y [i+4] ;
-    }
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+:t) schedule(static)
+#endif
+    for (i = 0; i < n; i++) t += x [i]*y [i] ;
     return (t) ;
 }
 
@@ -1030,22 +1029,11 @@ void cg_step
     int         n   /* length of the vectors */
 )
 {
-    int n5, i ;
-    n5 = n % 5 ;
-    for (i = 0; i < n5; i++) xtemp [i] = x[i] + alpha*d[i] ;
-    for (; i < n;)
-    { 
-        xtemp [i] = x [i] + alpha*d [i] ;
-        i++ ;
-        xtemp [i] = x [i] + alpha*d [i] ;
-        i++ ;
-        xtemp [i] = x [i] + alpha*d [i] ;
-        i++ ;
-        xtemp [i] = x [i] + alpha*d [i] ;
-        i++ ;
-        xtemp [i] = x [i] + alpha*d [i] ;
-        i++ ;
-    }
+    int i ;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (i = 0; i < n; i++) xtemp [i] = x[i] + alpha*d[i] ;
 }
 
 /* approximate Wolfe line search routine */
@@ -1058,9 +1046,9 @@ int cg_line
     double          *d , /* current search direction */
     double      *gtemp , /* gradient at x + alpha*d */
     double  (*cg_value)  /* user provided routine to return the function */
-             (double *), /* value at x */
+             (double *, void *), /* value at x */
     void     (*cg_grad)  /* user provided routine, returns in g the */
-   (double *, double *), /* gradient at x*/
+   (double *, double *, void *), /* gradient at x*/
     cg_parameter *Parm      /* cg parameters */
 )
 {
@@ -1072,7 +1060,7 @@ int cg_line
         cg_Wolfe (double, double, double, cg_parameter *),
         cg_update (double *, double *, double *, double *, double *, double *,
                    double *, double *, double *, double *, double *,
-                   double (double *), void (double *, double *),
+                   double (double *, void *), void (double *, double *, void *),
                    cg_parameter *) ;
 
     alpha = Parm->alpha ;
@@ -1081,7 +1069,7 @@ int cg_line
     n = Parm->n ;
     zero = 0. ;
     cg_step (xtemp, x, d, alpha, n) ;
-    cg_grad (gtemp, xtemp) ;
+    cg_grad (gtemp, xtemp, Parm->User) ;
     Parm->ng++ ;
     dphi = cg_dot (gtemp, d, n) ;
  
@@ -1094,7 +1082,7 @@ int cg_line
     nshrink = 0 ;
     while ( dphi < zero )
     {
-        phi = cg_value (xtemp) ;
+        phi = cg_value (xtemp, Parm->User) ;
         Parm->nf++ ;
 
 /* if quadstep in effect and quadratic conditions hold, check wolfe condition*/
@@ -1137,11 +1125,11 @@ int cg_line
                     goto Exit ;
                 }
                 cg_step (xtemp, x, d, alpha, n) ;
-                cg_grad (gtemp, xtemp) ;
+                cg_grad (gtemp, xtemp, Parm->User) ;
                 Parm->ng++ ;
                 dphi = cg_dot (gtemp, d, n) ;
                 if ( dphi >= zero ) goto Secant ;
-                phi = cg_value (xtemp) ;
+                phi = cg_value (xtemp, Parm->User) ;
                 Parm->nf++ ;
                 if ( Parm->PrintLevel )
                 {
@@ -1178,7 +1166,7 @@ int cg_line
         }
         alpha = Parm->rho*alpha ;
         cg_step (xtemp, x, d, alpha, n) ;
-        cg_grad (gtemp, xtemp) ;
+        cg_grad (gtemp, xtemp, Parm->User) ;
         Parm->ng++ ;
         dphi = cg_dot (gtemp, d, n) ;
         if ( Parm->PrintLevel )
@@ -1193,7 +1181,7 @@ Secant:
     dphib = dphi ;
     if ( Parm->QuadOK )
     {
-        phi = cg_value (xtemp) ;
+        phi = cg_value (xtemp, Parm->User) ;
         Parm->nf++ ;
         if ( ngrow + nshrink == 0 ) fquad = MIN (phi, Parm->f0) ;
         if ( phi <= fquad )
@@ -1285,9 +1273,9 @@ int cg_lineW
     double          *d , /* current search direction */
     double      *gtemp , /* gradient at x + alpha*d */
     double  (*cg_value)  /* user provided routine to return the function */
-             (double *), /* value at x */
+             (double *, void *), /* value at x */
     void     (*cg_grad)  /* user provided routine, returns in g the */
-    (double *, double*), /* gradient at x*/
+    (double *, double *, void *), /* gradient at x*/
     cg_parameter *Parm      /* cg parameters */
 )
 {
@@ -1299,7 +1287,7 @@ int cg_lineW
         cg_Wolfe (double, double, double, cg_parameter *),
         cg_updateW (double *, double *, double *, double *, double *, double *,
                     double *, double *, double *, double *, double *, double *,
-                    double (double *), void (double *, double *),
+                    double (double *, void *), void (double *, double *, void *),
                     cg_parameter *) ;
 
     alpha = Parm->alpha ;
@@ -1308,7 +1296,7 @@ int cg_lineW
     n = Parm->n ;
     zero = 0. ;
     cg_step (xtemp, x, d, alpha, n) ;
-    cg_grad (gtemp, xtemp) ;
+    cg_grad (gtemp, xtemp, Parm->User) ;
     Parm->ng++ ;
     dphi = cg_dot (gtemp, d, n) ;
     dpsi = dphi - Parm->wolfe_hi ;
@@ -1322,7 +1310,7 @@ int cg_lineW
     nshrink = 0 ;
     while ( dpsi < zero )
     {
-        phi = cg_value (xtemp) ;
+        phi = cg_value (xtemp, Parm->User) ;
         psi = phi - alpha*Parm->wolfe_hi ;
         Parm->nf++ ;
 
@@ -1366,12 +1354,12 @@ int cg_lineW
                     goto Exit ;
                 }
                 cg_step (xtemp, x, d, alpha, n) ;
-                cg_grad (gtemp, xtemp) ;
+                cg_grad (gtemp, xtemp, Parm->User) ;
                 Parm->ng++ ;
                 dphi = cg_dot (gtemp, d, n) ;
                 dpsi = dphi - Parm->wolfe_hi ;
                 if ( dpsi >= zero ) goto Secant ;
-                phi = cg_value (xtemp) ;
+                phi = cg_value (xtemp, Parm->User) ;
                 psi = phi - alpha*Parm->wolfe_hi ;
                 Parm->nf++ ;
                 if ( Parm->PrintLevel )
@@ -1409,7 +1397,7 @@ int cg_lineW
         }
         alpha = Parm->rho*alpha ;
         cg_step (xtemp, x, d, alpha, n) ;
-        cg_grad (gtemp, xtemp) ;
+        cg_grad (gtemp, xtemp, Parm->User) ;
         Parm->ng++ ;
         dphi = cg_dot (gtemp, d, n) ;
         dpsi = dphi - Parm->wolfe_hi ;
@@ -1425,7 +1413,7 @@ Secant:
     dpsib = dpsi ;
     if ( Parm->QuadOK )
     {
-        phi = cg_value (xtemp) ;
+        phi = cg_value (xtemp, Parm->User) ;
         Parm->nf++ ;
         if ( ngrow + nshrink == 0 ) fquad = MIN (phi, Parm->f0) ;
         if ( phi <= fquad )
@@ -1521,9 +1509,9 @@ int cg_update
     double          *d , /* current search direction */
     double      *gtemp , /* gradient at x + alpha*d */
     double    (*cg_value)  /* user provided routine to return the function */
-               (double *), /* value at x */
+               (double *, void *), /* value at x */
     void       (*cg_grad)  /* user provided routine, returns in g the */
-      (double *, double*), /* gradient at x*/
+      (double *, double *, void *), /* gradient at x*/
     cg_parameter *Parm   /* cg parameters */
 )
 {
@@ -1533,9 +1521,9 @@ int cg_update
     zero = 0. ;
     n = Parm->n ;
     cg_step (xtemp, x, d, *alpha, n) ;
-    *phi = cg_value (xtemp) ;
+    *phi = cg_value (xtemp, Parm->User) ;
     Parm->nf++ ;
-    cg_grad (gtemp, xtemp) ;
+    cg_grad (gtemp, xtemp, Parm->User) ;
     Parm->ng++ ;
     *dphi = cg_dot (gtemp, d, n) ;
     if ( Parm->PrintLevel )
@@ -1576,10 +1564,10 @@ int cg_update
             goto Exit2 ;
         }
         cg_step (xtemp, x, d, *alpha, n) ;
-        cg_grad (gtemp, xtemp) ;
+        cg_grad (gtemp, xtemp, Parm->User) ;
         Parm->ng++ ;
         *dphi = cg_dot (gtemp, d, n) ;
-        *phi = cg_value (xtemp) ;
+        *phi = cg_value (xtemp, Parm->User) ;
         Parm->nf++ ;
         if ( Parm->PrintLevel )
         {
@@ -1642,9 +1630,9 @@ int cg_updateW
     double          *d , /* current search direction */
     double      *gtemp , /* gradient at x + alpha*d */
     double    (*cg_value)  /* user provided routine to return the function */
-               (double *), /* value at x */
+               (double *, void *), /* value at x */
     void       (*cg_grad)  /* user provided routine, returns in g the */
-      (double *, double*), /* gradient at x*/
+      (double *, double *, void *), /* gradient at x*/
     cg_parameter *Parm   /* cg parameters */
 )
 {
@@ -1654,10 +1642,10 @@ int cg_updateW
     zero = 0. ;
     n = Parm->n ;
     cg_step (xtemp, x, d, *alpha, n) ;
-    *phi = cg_value (xtemp) ;
+    *phi = cg_value (xtemp, Parm->User) ;
     psi = *phi - *alpha*Parm->wolfe_hi ;
     Parm->nf++ ;
-    cg_grad (gtemp, xtemp) ;
+    cg_grad (gtemp, xtemp, Parm->User) ;
     Parm->ng++ ;
     *dphi = cg_dot (gtemp, d, n) ;
     *dpsi = *dphi - Parm->wolfe_hi ;
@@ -1699,11 +1687,11 @@ int cg_updateW
             goto Exit2 ;
         }
         cg_step (xtemp, x, d, *alpha, n) ;
-        cg_grad (gtemp, xtemp) ;
+        cg_grad (gtemp, xtemp, Parm->User) ;
         Parm->ng++ ;
         *dphi = cg_dot (gtemp, d, n) ;
         *dpsi = *dphi - Parm->wolfe_hi ;
-        *phi = cg_value (xtemp) ;
+        *phi = cg_value (xtemp, Parm->User) ;
         psi = *phi - *alpha*Parm->wolfe_hi ;
         Parm->nf++ ;
         if ( Parm->PrintLevel )
@@ -91,6 +91,7 @@ typedef struct cg_parameter_struct
                                    arguement of cg_descent) */
     int              debug ; /* F (no debugging)
                                 T (check for no increase in function value)*/
+    void             *User ; /* user context passed to cg_value and cg_grad */
 } cg_parameter ;
 
 int cg_descent /*  return  0 (convergence tolerance satisfied)
@@ -111,13 +112,14 @@ int cg_descent /*  return  0 (convergence tolerance satisfied)
     double            *x , /* input: starting guess, output: the solution */
     int              dim , /* problem dimension (also denoted n) */
     double    (*cg_value)  /* user provided routine to return the function */
-               (double *), /* value at x */
+               (double *, void *), /* value at x */
     void       (*cg_grad)  /* user provided routine, returns in g the */
-      (double *, double*), /* gradient at x*/
+      (double *, double *, void *), /* gradient at x*/
     double         *work , /* working array with at least 4n elements */
     double          step , /* initial step for line search
                               ignored unless Step != 0 in cg.parm */
-    cg_stats      *Stats   /* structure with statistics(see cg_descent.h) */
+    cg_stats      *Stats , /* structure with statistics(see cg_descent.h) */
+    void           *User   /* passed unchanged to cg_value and cg_grad */
 ) ;
 
 int  cg_descent_init
@@ -165,9 +167,9 @@ int cg_line
     double          *d , /* current search direction */
     double      *gtemp , /* gradient at x + alpha*d */
     double    (*cg_value)  /* user provided routine to return the function */
-               (double *), /* value at x */
+               (double *, void *), /* value at x */
     void       (*cg_grad)  /* user provided routine, returns in g the */
-      (double *, double*), /* gradient at x*/
+      (double *, double *, void *), /* gradient at x*/
     cg_parameter *Parm      /* cg parameters */
 ) ;
 
@@ -179,9 +181,9 @@ int cg_lineW
     double          *d , /* current search direction */
     double      *gtemp , /* gradient at x + alpha*d */
     double    (*cg_value)  /* user provided routine to return the function */
-               (double *), /* value at x */
+               (double *, void *), /* value at x */
     void       (*cg_grad)  /* user provided routine, returns in g the */
-      (double *, double*), /* gradient at x*/
+      (double *, double *, void *), /* gradient at x*/
     cg_parameter *Parm      /* cg parameters */
 ) ;
 
@@ -199,9 +201,9 @@ int cg_update
     double          *d , /* current serach direction */
     double      *gtemp , /* gradient at x + alpha*d */
     double    (*cg_value)  /* user provided routine to return the function */
-               (double *), /* value at x */
+               (double *, void *), /* value at x */
     void       (*cg_grad)  /* user provided routine, returns in g the */
-      (double *, double*), /* gradient at x*/
+      (double *, double *, void *), /* gradient at x*/
     cg_parameter *Parm   /* cg parameters */
 ) ;
 
@@ -220,8 +222,8 @@ int cg_updateW
     double          *d , /* current search direction */
     double      *gtemp , /* gradient at x + alpha*d */
     double    (*cg_value)  /* user provided routine to return the function */
-               (double *), /* value at x */
+               (double *, void *), /* value at x */
     void       (*cg_grad)  /* user provided routine, returns in g the */
-      (double *, double*), /* gradient at x*/
+      (double *, double *, void *), /* gradient at x*/
     cg_parameter *Parm   /* cg parameters */
 ) ;
@@ -0,0 +1,223 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include "Lanczos.h"
+#include "RandomStream.h"
+
+// LAPACK FORTRAN subroutine for symmetric eigenvalue problems
+extern "C" void dsyev_(char *jobz, char *uplo, int *n, double *a, int *lda,
+                       double *w, double *work, int *lwork, int *info);
+
+namespace voom {
+
+  namespace {
+
+    double dot(int n, const double * a, const double * b) {
+      double s = 0.0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+:s) schedule(static)
+#endif
+      for(int i=0; i<n; i++) s += a[i]*b[i];
+      return s;
+    }
+
+    void axpy(int n, double alpha, const double * x, double * y) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+      for(int i=0; i<n; i++) y[i] += alpha*x[i];
+    }
+
+    //! w -= sum_i (q_i.w) q_i for the k vectors q; returns coefficients in c
+    void project(int n, int k, const double * Q, double * w, double * c) {
+      for(int i=0; i<k; i++) {
+	const double ci = dot(n, Q + i*n, w);
+	axpy(n, -ci, Q + i*n, w);
+	if(c) c[i] += ci;
+      }
+    }
+
+    //! Set column k of V to a random unit vector orthogonal to the
+    //! deflation space and to the first k columns
+    void randomDirection(int n, int nDefl, const double * D, int k,
+			 double * V, RandomStream & rng) {
+      double * v = V + k*n;
+      for(int i=0; i<n; i++) v[i] = rng.uniform() - 0.5;
+      project(n, nDefl, D, v, 0);
+      project(n, k, V, v, 0);
+      project(n, k, V, v, 0);
+      const double s = std::sqrt(dot(n, v, v));
+      for(int i=0; i<n; i++) v[i] /= s;
+    }
+
+    //! eigenvalues (ascending) and eigenvectors (columns) of dense symmetric H
+    void denseEigen(int m, std::vector<double> & H, std::vector<double> & theta) {
+      char jobz = 'V', uplo = 'L';
+      int lda = m, info = 0, lwork = -1;
+      double query;
+      theta.resize(m);
+      dsyev_(&jobz, &uplo, &m, &H[0], &lda, &theta[0], &query, &lwork, &info);
+      lwork = static_cast<int>(query);
+      std::vector<double> work(lwork);
+      dsyev_(&jobz, &uplo, &m, &H[0], &lda, &theta[0], &work[0], &lwork, &info);
+      if(info != 0) {
+	std::cout << "lanczos: DSYEV failed with info = " << info << std::endl;
+	exit(0);
+      }
+    }
+  }
+
+
+
+  int orthonormalize(std::vector<double> & vectors, int n) {
+    const int k = (n > 0 ? vectors.size()/n : 0);
+    int kept = 0;
+    for(int i=0; i<k; i++) {
+      double * v = &vectors[i*n];
+      const double norm0 = std::sqrt(dot(n, v, v));
+      if(norm0 == 0.0) continue;
+      // twice is enough
+      project(n, kept, &vectors[0], v, 0);
+      project(n, kept, &vectors[0], v, 0);
+      const double norm = std::sqrt(dot(n, v, v));
+      if(norm <= 1.0e-10*norm0) continue;
+      for(int j=0; j<n; j++) vectors[kept*n+j] = v[j]/norm;
+      kept++;
+    }
+    vectors.resize(kept*n);
+    return kept;
+  }
+
+
+
+  int lanczos(SymmetricOperator & A, int nev,
+	      std::vector<double> & values,
+	      std::vector<double> * vectors,
+	      const std::vector<double> & deflation,
+	      double tol, int maxRestarts, int basisSize, int blockSize,
+	      unsigned long long seed, bool verbose) {
+    const int n = A.size();
+    const int nDefl = (n > 0 ? deflation.size()/n : 0);
+    const double * D = (nDefl > 0 ? &deflation[0] : 0);
+    const int dim = n - nDefl;
+
+    int b = std::max(1, std::min(blockSize, dim));
+    int m = (basisSize > 0 ? basisSize : 2*nev + 20);
+    m = std::min(std::max(m, nev + 2*b), dim);
+    nev = std::min(nev, m);
+    b = std::min(b, m);
+    values.clear();
+    if(vectors) vectors->clear();
+    if(nev <= 0) return 0;
+
+    std::vector<double> V(m*n, 0.0);      // Krylov basis, one vector after the other
+    std::vector<double> H(m*m, 0.0);      // projected matrix (column major)
+    std::vector<double> R(b*n, 0.0);      // residuals of products that left the basis
+    std::vector<int> rIndex(b);           // basis index of each residual
+    std::vector<double> w(n), Y, theta, c(m), residual(m);
+    RandomStream rng(seed);
+
+    // random start block, orthogonal to the deflation space
+    for(int k=0; k<b; k++) randomDirection(n, nDefl, D, k, &V[0], rng);
+
+    int l = 0, k = b, nconv = 0;
+    for(int restart=0; restart<=maxRestarts; restart++) {
+
+      // extend the basis to m vectors; A v_j lies in the span of the
+      // first k vectors plus a residual, which becomes v_k while
+      // there is room and is kept in R afterwards
+      int nr = 0;
+      for(int j=l; j<m; j++) {
+	A.multiply(&V[j*n], &w[0]);
+	project(n, nDefl, D, &w[0], 0);
+
+	// full reorthogonalization, twice; the coefficients are
+	// column j of the projected matrix
+	std::fill(c.begin(), c.end(), 0.0);
+	project(n, k, &V[0], &w[0], &c[0]);
+	project(n, k, &V[0], &w[0], &c[0]);
+	for(int i=0; i<k; i++) H[i + j*m] = H[j + i*m] = c[i];
+
+	double beta = std::sqrt(dot(n, &w[0], &w[0]));
+	if(k < m) {
+	  if(beta < 1.0e-12*std::max(1.0, std::fabs(c[j]))) {
+	    // invariant subspace found; continue with a fresh direction
+	    randomDirection(n, nDefl, D, k, &V[0], rng);
+	    beta = 0.0;
+	  } else {
+	    for(int i=0; i<n; i++) V[k*n+i] = w[i]/beta;
+	  }
+	  H[k + j*m] = H[j + k*m] = beta;
+	  k++;
+	} else {
+	  std::copy(w.begin(), w.end(), &R[nr*n]);
+	  rIndex[nr++] = j;
+	}
+      }
+
+      // Rayleigh-Ritz; the residual of Ritz pair i is sum_p Y(j_p,i) r_p
+      Y = H;
+      denseEigen(m, Y, theta);
+      std::vector<double> G(nr*nr);
+      for(int p=0; p<nr; p++)
+	for(int q=0; q<=p; q++) G[p + q*nr] = G[q + p*nr] = dot(n, &R[p*n], &R[q*n]);
+      double scale = 0.0;
+      for(int i=0; i<m; i++) scale = std::max(scale, std::fabs(theta[i]));
+      nconv = 0;
+      for(int i=0; i<m; i++) {
+	double r2 = 0.0;
+	for(int p=0; p<nr; p++)
+	  for(int q=0; q<nr; q++)
+	    r2 += Y[rIndex[p] + i*m]*G[p + q*nr]*Y[rIndex[q] + i*m];
+	residual[i] = std::sqrt(std::max(r2, 0.0));
+	if(i < nev && residual[i] <= tol*scale && nconv == i) nconv++;
+      }
+      if(verbose) {
+	std::cout << "lanczos: restart " << restart << " | converged " << nconv
+		  << " of " << nev << " | lowest Ritz value " << theta[0]
+		  << " | residual of pair " << nev-1 << " = " << residual[nev-1]
+		  << std::endl;
+      }
+      if(nconv >= nev || restart == maxRestarts || m == dim) break;
+
+      // thick restart: keep the lowest l Ritz vectors, followed by the
+      // residual block orthonormalized against them; leave room for at
+      // least one more block
+      l = std::min(nev + (m-nev)/2, m - 2*b);
+      std::vector<double> W(l*n, 0.0);
+      for(int i=0; i<l; i++)
+	for(int j=0; j<m; j++) axpy(n, Y[j + i*m], &V[j*n], &W[i*n]);
+      std::copy(W.begin(), W.end(), V.begin());
+      std::vector<double> Q(R.begin(), R.begin() + nr*n);
+      for(int p=0; p<nr; p++) {
+	project(n, l, &V[0], &Q[p*n], 0);
+	project(n, l, &V[0], &Q[p*n], 0);
+      }
+      const int nq = orthonormalize(Q, n);
+      std::copy(Q.begin(), Q.end(), &V[l*n]);
+      k = l + nq;
+      if(nq == 0) randomDirection(n, nDefl, D, k++, &V[0], rng);
+      std::fill(H.begin(), H.end(), 0.0);
+      for(int i=0; i<l; i++) H[i + i*m] = theta[i];
+    }
+
+    values.assign(theta.begin(), theta.begin()+nev);
+    if(vectors) {
+      vectors->assign(nev*n, 0.0);
+      for(int i=0; i<nev; i++)
+	for(int j=0; j<m; j++) axpy(n, Y[j + i*m], &V[j*n], &(*vectors)[i*n]);
+    }
+    return nconv;
+  }
+
+}; // namespace voom
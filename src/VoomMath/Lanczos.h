@@ -0,0 +1,74 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+
+/*!
+  \file Lanczos.h
+
+  \brief Thick-restart block Lanczos eigensolver for the lowest eigenpairs
+  of a large symmetric operator known only through matrix-vector
+  products.
+
+*/
+
+#if !defined(__Lanczos_h__)
+#define __Lanczos_h__
+
+#include <vector>
+
+namespace voom
+{
+
+  /*!  A symmetric linear operator of dimension size(), applied as
+    y = A x.  Only the product is needed, so A may be an assembled
+    sparse matrix or a finite difference of gradients.
+  */
+  class SymmetricOperator
+  {
+  public:
+    virtual ~SymmetricOperator() {}
+    virtual int size() const = 0;
+    virtual void multiply(const double * x, double * y) = 0;
+  };
+
+  //! Lowest nev eigenpairs of A on the complement of a deflation space
+  /*! Thick-restart block Lanczos with full reorthogonalization.  The
+    Krylov space is grown from blockSize vectors at once, so an
+    eigenvalue of multiplicity up to blockSize is resolved; a single
+    vector (blockSize=1) finds only one copy of a repeated
+    eigenvalue.  The basis holds basisSize vectors (default 2*nev+20,
+    at least nev+2*blockSize); on restart the lowest Ritz vectors and
+    the residual block are kept and the basis is extended again.  A
+    Ritz pair is converged when its residual norm is below tol times
+    the largest Ritz value.
+
+    deflation holds nDeflation orthonormal vectors of length n, one
+    after the other; they are projected out of every Krylov vector,
+    e.g. to remove known zero-energy (rigid-body) modes.
+
+    On return values holds the nev lowest Ritz values in ascending
+    order and, if vectors is not null, vectors holds the matching
+    orthonormal Ritz vectors one after the other.  Returns the number
+    of converged pairs.
+  */
+  int lanczos(SymmetricOperator & A, int nev,
+	      std::vector<double> & values,
+	      std::vector<double> * vectors,
+	      const std::vector<double> & deflation,
+	      double tol=1.0e-8, int maxRestarts=100,
+	      int basisSize=-1, int blockSize=6, unsigned long long seed=1,
+	      bool verbose=false);
+
+  //! Orthonormalize vectors (n each, one after the other) in place
+  /*! Vectors that are (numerically) dependent on earlier ones are
+    removed.  Returns the number kept. */
+  int orthonormalize(std::vector<double> & vectors, int n);
+
+}; // namespace voom
+
+#endif // __Lanczos_h__
@@ -0,0 +1,244 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+
+#include <cmath>
+#include <algorithm>
+#include "Multigrid.h"
+
+namespace voom {
+
+  void Prolongation::addRow(const std::vector<int> & cols,
+			    const std::vector<double> & weights) {
+    for(int k=0; k<cols.size(); k++) {
+      _col.push_back(cols[k]);
+      _val.push_back(weights[k]);
+      if( cols[k]+1 > _cols ) _cols = cols[k]+1;
+    }
+    _rowPtr.push_back(_col.size());
+  }
+
+  void Prolongation::multiply(const double * xc, double * xf) const {
+    const int n = rows();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(int i=0; i<n; i++) {
+      double s = 0.0;
+      for(int k=_rowPtr[i]; k<_rowPtr[i+1]; k++) s += _val[k]*xc[_col[k]];
+      xf[i] = s;
+    }
+  }
+
+  void Prolongation::multiplyTranspose(const double * xf, double * xc) const {
+    for(int j=0; j<_cols; j++) xc[j] = 0.0;
+    for(int i=0; i<rows(); i++)
+      for(int k=_rowPtr[i]; k<_rowPtr[i+1]; k++) xc[_col[k]] += _val[k]*xf[i];
+  }
+
+  Prolongation Prolongation::expand(int dof) const {
+    Prolongation E;
+    std::vector<int> cols;
+    std::vector<double> weights;
+    for(int i=0; i<rows(); i++) {
+      for(int d=0; d<dof; d++) {
+	cols.clear();
+	weights.clear();
+	for(int k=_rowPtr[i]; k<_rowPtr[i+1]; k++) {
+	  cols.push_back(dof*_col[k]+d);
+	  weights.push_back(_val[k]);
+	}
+	E.addRow(cols, weights);
+      }
+    }
+    E._cols = dof*_cols;
+    return E;
+  }
+
+
+
+  void Multigrid::setHierarchy(const std::vector<Prolongation> & prolongations) {
+    _P = prolongations;
+    const int L = _P.size();
+    for(int l=1; l<L; l++) {
+      if( _P[l].cols() > _P[l-1].rows() ) {
+	std::cout << "Multigrid: prolongation " << l << " has " << _P[l].cols()
+		  << " coarse values but level " << l << " has " << _P[l-1].rows()
+		  << "." << std::endl;
+	exit(0);
+      }
+    }
+
+    // transposes, one row per coarse value
+    _PT.assign(L, Prolongation());
+    for(int l=0; l<L; l++) {
+      const Prolongation & P = _P[l];
+      const int nc = ( l > 0 ? _P[l-1].rows() : P.cols() );
+      std::vector< std::vector<int> > cols(nc);
+      std::vector< std::vector<double> > weights(nc);
+      for(int i=0; i<P.rows(); i++) {
+	for(int k=P.rowPointers()[i]; k<P.rowPointers()[i+1]; k++) {
+	  cols[P.columns()[k]].push_back(i);
+	  weights[P.columns()[k]].push_back(P.values()[k]);
+	}
+      }
+      for(int j=0; j<nc; j++) _PT[l].addRow(cols[j], weights[j]);
+    }
+
+    // operators are rebuilt (with new patterns) by setOperator
+    _A.assign(L+1, SparseMatrix());
+    _dinv.assign(L+1, std::vector<double>());
+    _b.assign(L+1, std::vector<double>());
+    _x.assign(L+1, std::vector<double>());
+    _r.assign(L+1, std::vector<double>());
+  }
+
+
+
+  void Multigrid::setOperator(const SparseMatrix & A) {
+    const int L = _P.size();
+    if( _A.size() != L+1 ) setHierarchy(_P);
+    if( L > 0 && A.size() != _P.back().rows() ) {
+      std::cout << "Multigrid: operator of size " << A.size()
+		<< " does not match the finest level of the hierarchy ("
+		<< _P.back().rows() << ")." << std::endl;
+      exit(0);
+    }
+
+    _A[L] = A;
+    for(int l=L-1; l>=0; l--) _galerkin(l);
+
+    for(int l=0; l<=L; l++) {
+      const int n = _A[l].size();
+      _dinv[l].resize(n);
+      _A[l].diagonal(&_dinv[l][0]);
+      for(int i=0; i<n; i++) _dinv[l][i] = ( _dinv[l][i] > 0.0 ? 1.0/_dinv[l][i] : 0.0 );
+      _b[l].resize(n);
+      _x[l].resize(n);
+      _r[l].resize(n);
+    }
+  }
+
+
+
+  //! A_l = P_l^T A_{l+1} P_l, row by row with a dense accumulator
+  void Multigrid::_galerkin(int l) {
+    const SparseMatrix & Af = _A[l+1];
+    const Prolongation & P = _P[l];
+    const Prolongation & PT = _PT[l];
+    const int nc = PT.rows();
+    SparseMatrix & Ac = _A[l];
+
+    const std::vector<int> & aPtr = Af.rowPointers();
+    const std::vector<int> & aCol = Af.columns();
+    const std::vector<double> & aVal = Af.values();
+    const std::vector<int> & pPtr = P.rowPointers();
+    const std::vector<int> & pCol = P.columns();
+    const std::vector<double> & pVal = P.values();
+    const std::vector<int> & tPtr = PT.rowPointers();
+    const std::vector<int> & tCol = PT.columns();
+    const std::vector<double> & tVal = PT.values();
+
+    std::vector< std::vector<int> > rows(nc);
+    std::vector< std::vector<double> > rowValues(nc);
+    std::vector<double> acc(nc, 0.0);
+    std::vector<char> mark(nc, 0);
+
+    for(int I=0; I<nc; I++) {
+      std::vector<int> & touched = rows[I];
+      for(int t=tPtr[I]; t<tPtr[I+1]; t++) {
+	const int i = tCol[t];
+	for(int k=aPtr[i]; k<aPtr[i+1]; k++) {
+	  const double pa = tVal[t]*aVal[k];
+	  const int j = aCol[k];
+	  for(int m=pPtr[j]; m<pPtr[j+1]; m++) {
+	    const int J = pCol[m];
+	    if( !mark[J] ) { mark[J] = 1; touched.push_back(J); }
+	    acc[J] += pa*pVal[m];
+	  }
+	}
+      }
+      rowValues[I].resize(touched.size());
+      for(int k=0; k<touched.size(); k++) {
+	rowValues[I][k] = acc[touched[k]];
+	acc[touched[k]] = 0.0;
+	mark[touched[k]] = 0;
+      }
+    }
+
+    // the pattern only depends on the hierarchy and the fine pattern
+    if( !Ac.hasPattern() || Ac.size() != nc ) Ac.setPattern(rows);
+    Ac.zero();
+    for(int I=0; I<nc; I++)
+      for(int k=0; k<rows[I].size(); k++) Ac.add(I, rows[I][k], rowValues[I][k]);
+  }
+
+
+
+  void Multigrid::_smooth(int l, bool forward) const {
+    const SparseMatrix & A = _A[l];
+    const std::vector<int> & ptr = A.rowPointers();
+    const std::vector<int> & col = A.columns();
+    const std::vector<double> & val = A.values();
+    const std::vector<double> & dinv = _dinv[l];
+    const std::vector<double> & b = _b[l];
+    std::vector<double> & x = _x[l];
+    const int n = A.size();
+
+    for(int s=0; s<n; s++) {
+      const int i = ( forward ? s : n-1-s );
+      if( dinv[i] == 0.0 ) continue;
+      double r = b[i];
+      for(int k=ptr[i]; k<ptr[i+1]; k++) r -= val[k]*x[col[k]];
+      x[i] += dinv[i]*r;
+    }
+  }
+
+
+
+  void Multigrid::_cycle(int l) const {
+    std::vector<double> & x = _x[l];
+    std::fill(x.begin(), x.end(), 0.0);
+
+    if( l == 0 ) {
+      double bb = 0.0;
+      for(int i=0; i<_b[0].size(); i++) bb += _b[0][i]*_b[0][i];
+      conjugateGradient(_A[0], &_b[0][0], &x[0], _coarseTol*std::sqrt(bb),
+			10*x.size()+10, 0);
+      return;
+    }
+
+    for(int s=0; s<_nu; s++) _smooth(l, true);
+
+    std::vector<double> & r = _r[l];
+    _A[l].multiply(&x[0], &r[0]);
+    for(int i=0; i<r.size(); i++) r[i] = _b[l][i] - r[i];
+    _PT[l-1].multiply(&r[0], &_b[l-1][0]);
+
+    _cycle(l-1);
+
+    _P[l-1].multiply(&_x[l-1][0], &r[0]);
+    for(int i=0; i<x.size(); i++) x[i] += r[i];
+
+    for(int s=0; s<_nu; s++) _smooth(l, false);
+  }
+
+
+
+  void Multigrid::apply(const double * r, double * z) const {
+    const int L = _A.size()-1;
+    if( L < 0 || _A[L].size() == 0 ) {
+      std::cout << "Multigrid: apply() called before setOperator()." << std::endl;
+      exit(0);
+    }
+    std::copy(r, r+_b[L].size(), _b[L].begin());
+    _cycle(L);
+    std::copy(_x[L].begin(), _x[L].end(), z);
+  }
+
+}; // namespace voom
@@ -0,0 +1,132 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+//
+// Reference:
+//  W. L. Briggs, V. E. Henson and S. F. McCormick, A Multigrid
+//  Tutorial, 2nd ed., SIAM (2000).
+//
+/////////////////////////////////////////////////////////////////////////
+
+/*!
+  \file Multigrid.h
+
+  \brief Geometric multigrid V-cycle on a hierarchy of nested meshes,
+  for use as a conjugate gradient preconditioner.
+
+*/
+
+#if !defined(__Multigrid_h__)
+#define __Multigrid_h__
+
+#include <vector>
+#include "SparseMatrix.h"
+
+namespace voom
+{
+
+  /*!  Rectangular sparse interpolation from a coarse to a fine
+    mesh: fine value i = sum_j P(i,j) coarse value j.  Rows are added
+    in order of the fine index.
+  */
+  class Prolongation
+  {
+  public:
+
+    Prolongation() : _cols(0) { _rowPtr.push_back(0); }
+
+    //! Append the next fine row
+    void addRow(const std::vector<int> & cols, const std::vector<double> & weights);
+
+    //! Number of fine (rows) and coarse (cols) values
+    int rows() const { return _rowPtr.size()-1; }
+    int cols() const { return _cols; }
+
+    //! xf = P xc
+    void multiply(const double * xc, double * xf) const;
+
+    //! xc = P^T xf
+    void multiplyTranspose(const double * xf, double * xc) const;
+
+    //! Same interpolation applied to each of dof values per node,
+    //! numbered node by node (value k of node a is dof*a+k)
+    Prolongation expand(int dof) const;
+
+    const std::vector<int> & rowPointers() const { return _rowPtr; }
+    const std::vector<int> & columns() const { return _col; }
+    const std::vector<double> & values() const { return _val; }
+
+  private:
+
+    int _cols;
+    std::vector<int> _rowPtr;
+    std::vector<int> _col;
+    std::vector<double> _val;
+  };
+
+
+
+  /*!  One V-cycle per application: on each level nu forward
+    Gauss-Seidel sweeps before restricting the residual and nu
+    backward sweeps after adding the coarse correction, so that the
+    cycle is a symmetric operator and can precondition CG.  The
+    coarse level operators are the Galerkin products P^T A P, so only
+    the finest matrix needs to be assembled; their sparsity patterns
+    are built on the first call to setOperator() and reused as long
+    as the hierarchy is unchanged.  The coarsest level is solved by
+    Jacobi CG.
+
+    prolongations[l] interpolates level l to level l+1; level 0 is the
+    coarsest and the last prolongation ends on the level of the
+    operator.
+  */
+  class Multigrid : public Preconditioner
+  {
+  public:
+
+    Multigrid(int nu=2, double coarseTol=1.0e-10) : _nu(nu), _coarseTol(coarseTol) {}
+
+    virtual ~Multigrid() {}
+
+    void setHierarchy(const std::vector<Prolongation> & prolongations);
+
+    //! Finest level operator; coarse operators are recomputed from it
+    void setOperator(const SparseMatrix & A);
+
+    //! z = V-cycle applied to r
+    void apply(const double * r, double * z) const;
+
+    int levels() const { return _A.size(); }
+
+    const SparseMatrix & levelOperator(int l) const { return _A[l]; }
+
+  private:
+
+    int _nu;
+    double _coarseTol;
+
+    std::vector<Prolongation> _P;
+    std::vector<SparseMatrix> _A;
+
+    //! transposes of the prolongations, for the Galerkin products
+    std::vector<Prolongation> _PT;
+
+    //! inverse diagonal of each level operator
+    std::vector< std::vector<double> > _dinv;
+
+    //! per level right hand side, solution and residual
+    mutable std::vector< std::vector<double> > _b, _x, _r;
+
+    void _galerkin(int l);
+    void _cycle(int l) const;
+    void _smooth(int l, bool forward) const;
+  };
+
+}; // namespace voom
+
+#endif // __Multigrid_h__
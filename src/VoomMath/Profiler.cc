@@ -0,0 +1,219 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+
+#include<fstream>
+#include<iomanip>
+#include<cstdlib>
+#include<cstring>
+#include<ctime>
+#include<sys/time.h>
+#include<cxxabi.h>
+
+#include "Profiler.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace voom
+{
+
+  bool Profiler::_enabled = false;
+  std::vector<Profiler::Region> Profiler::_regions;
+  std::vector<Profiler::Counter> Profiler::_counters;
+
+  namespace {
+
+    //! VOOM_PROFILE=file switches profiling on and writes file at exit
+    std::string profileFile;
+
+    void writeProfileAtExit() {
+      Profiler::write(profileFile);
+    }
+
+    struct ProfileFromEnvironment {
+      ProfileFromEnvironment() {
+	const char * file = getenv("VOOM_PROFILE");
+	if( file && *file ) {
+	  profileFile = file;
+	  Profiler::enable();
+	  atexit(writeProfileAtExit);
+	}
+      }
+    } profileFromEnvironment;
+
+    int threads() {
+#ifdef _OPENMP
+      return omp_get_max_threads();
+#else
+      return 1;
+#endif
+    }
+
+    //! JSON string literal
+    std::string quoted(const std::string & s) {
+      std::string q = "\"";
+      for(int i=0; i<s.size(); i++) {
+	if( s[i] == '"' || s[i] == '\\' ) q += '\\';
+	q += s[i];
+      }
+      return q + "\"";
+    }
+
+  }
+
+
+
+  int Profiler::region(const std::string & name) {
+    int r = -1;
+#ifdef _OPENMP
+#pragma omp critical(Profiler)
+#endif
+    {
+      for(int i=0; i<_regions.size() && r<0; i++)
+	if( _regions[i].name == name ) r = i;
+      if( r < 0 ) {
+	Region region = {name, 0, 0.0, 0.0};
+	_regions.push_back(region);
+	r = _regions.size()-1;
+      }
+    }
+    return r;
+  }
+
+
+
+  void Profiler::record(int region, double wall, double cpu) {
+#ifdef _OPENMP
+#pragma omp critical(Profiler)
+#endif
+    {
+      Region & r = _regions[region];
+      r.calls++;
+      r.wall += wall;
+      r.cpu += cpu;
+    }
+  }
+
+
+
+  void Profiler::_count(const char * name, long n) {
+#ifdef _OPENMP
+#pragma omp critical(Profiler)
+#endif
+    {
+      int c = -1;
+      for(int i=0; i<_counters.size() && c<0; i++)
+	if( _counters[i].name == name ) c = i;
+      if( c < 0 ) {
+	Counter counter = {name, 0};
+	_counters.push_back(counter);
+	c = _counters.size()-1;
+      }
+      _counters[c].value += n;
+    }
+  }
+
+
+
+  void Profiler::reset() {
+#ifdef _OPENMP
+#pragma omp critical(Profiler)
+#endif
+    {
+      _regions.clear();
+      _counters.clear();
+    }
+  }
+
+
+
+  double Profiler::wallTime() {
+#ifdef _OPENMP
+    return omp_get_wtime();
+#else
+    timeval t;
+    gettimeofday(&t, 0);
+    return t.tv_sec + 1.0e-6*t.tv_usec;
+#endif
+  }
+
+
+
+  double Profiler::cpuTime() {
+    timespec t;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &t);
+    return t.tv_sec + 1.0e-9*t.tv_nsec;
+  }
+
+
+
+  std::string Profiler::typeName(const std::type_info & type) {
+    int status = 0;
+    char * name = abi::__cxa_demangle(type.name(), 0, 0, &status);
+    std::string s = ( status == 0 && name ? name : type.name() );
+    free(name);
+    return s;
+  }
+
+
+
+  void Profiler::write(std::ostream & os, bool json) {
+    const int T = threads();
+    if( json ) {
+      os << "{" << std::endl
+	 << "  \"threads\": " << T << "," << std::endl
+	 << "  \"regions\": [" << std::endl;
+      for(int i=0; i<_regions.size(); i++) {
+	const Region & r = _regions[i];
+	os << "    {\"name\": " << quoted(r.name)
+	   << ", \"calls\": " << r.calls
+	   << ", \"wall\": " << r.wall
+	   << ", \"mean\": " << ( r.calls > 0 ? r.wall/r.calls : 0.0 )
+	   << ", \"cpu\": " << r.cpu
+	   << ", \"utilization\": " << ( r.wall > 0.0 ? r.cpu/(r.wall*T) : 0.0 )
+	   << "}" << ( i+1 < _regions.size() ? "," : "" ) << std::endl;
+      }
+      os << "  ]," << std::endl
+	 << "  \"counters\": {";
+      for(int i=0; i<_counters.size(); i++) {
+	os << ( i > 0 ? ", " : "" ) << quoted(_counters[i].name) << ": " << _counters[i].value;
+      }
+      os << "}" << std::endl
+	 << "}" << std::endl;
+      return;
+    }
+
+    os << "region,calls,wall,mean,cpu,utilization" << std::endl;
+    for(int i=0; i<_regions.size(); i++) {
+      const Region & r = _regions[i];
+      os << quoted(r.name) << "," << r.calls << "," << r.wall << ","
+	 << ( r.calls > 0 ? r.wall/r.calls : 0.0 ) << "," << r.cpu << ","
+	 << ( r.wall > 0.0 ? r.cpu/(r.wall*T) : 0.0 ) << std::endl;
+    }
+    os << std::endl << "counter,value" << std::endl;
+    for(int i=0; i<_counters.size(); i++)
+      os << quoted(_counters[i].name) << "," << _counters[i].value << std::endl;
+  }
+
+
+
+  void Profiler::write(const std::string & fileName) {
+    std::ofstream ofs(fileName.c_str());
+    if (!ofs) {
+      std::cout << "Cannot open output file " << fileName << std::endl;
+      return;
+    }
+    const bool json = fileName.size() >= 5 &&
+      fileName.compare(fileName.size()-5, 5, ".json") == 0;
+    write(ofs, json);
+    ofs.close();
+  }
+
+}; // namespace voom
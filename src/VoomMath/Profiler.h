@@ -0,0 +1,138 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+
+/*!
+  \file Profiler.h
+
+  \brief Scoped timers and event counters for finding where the time
+  of a run goes.
+
+*/
+
+#if !defined(__Profiler_h__)
+#define __Profiler_h__
+
+#include<string>
+#include<vector>
+#include<iostream>
+#include<typeinfo>
+
+namespace voom
+{
+
+  /*!  Process wide collection of named timing regions and counters.
+    A region accumulates the number of calls and the wall clock and
+    process CPU time spent in it; the ratio of CPU to wall time over
+    the number of threads is the thread utilization of the region.
+
+    Profiling is off by default and then costs one test of a static
+    flag per instrumented scope.  It is switched on by enable(), or by
+    setting the environment variable VOOM_PROFILE to a file name, in
+    which case the summary is also written to that file (JSON if the
+    name ends in .json, CSV otherwise) when the program exits.
+
+    \code
+    {
+      Profiler::Scope scope("LoopShellBody::compute");
+      ...
+    }
+    Profiler::count("energy evaluations");
+    Profiler::write("profile.json");
+    \endcode
+
+    Where building the region name costs something, guard it:
+    \code
+    Profiler::Scope scope( Profiler::enabled() ? Profiler::region(name()) : -1 );
+    \endcode
+
+    Regions and counters are meant for coarse grained code (bodies,
+    constraints, solver stages); recording takes a lock, so scopes
+    should not be opened per element inside parallel loops.
+  */
+  class Profiler
+  {
+  public:
+
+    //! Times a scope if profiling is enabled
+    class Scope
+    {
+    public:
+      Scope(const char * name) : _region(-1) {
+	if( Profiler::enabled() ) _start( Profiler::region(name) );
+      }
+      Scope(int region) : _region(-1) {
+	if( region >= 0 ) _start(region);
+      }
+      ~Scope() {
+	if( _region >= 0 )
+	  Profiler::record(_region, Profiler::wallTime() - _wall, Profiler::cpuTime() - _cpu);
+      }
+    private:
+      int _region;
+      double _wall, _cpu;
+      void _start(int region) {
+	_region = region;
+	_wall = Profiler::wallTime();
+	_cpu = Profiler::cpuTime();
+      }
+    };
+
+    static bool enabled() { return _enabled; }
+
+    static void enable(bool on=true) { _enabled = on; }
+
+    //! Index of the region with this name (created on first use)
+    static int region(const std::string & name);
+
+    //! Add one call of duration wall (and cpu seconds) to a region
+    static void record(int region, double wall, double cpu);
+
+    //! Increment a named counter
+    static void count(const char * name, long n=1) {
+      if( _enabled ) _count(name, n);
+    }
+
+    //! Forget all regions and counters
+    static void reset();
+
+    //! Summary as a table, or as JSON
+    static void write(std::ostream & os, bool json=false);
+
+    //! Summary to a file, JSON if the name ends in .json, else CSV
+    static void write(const std::string & fileName);
+
+    static double wallTime();
+    static double cpuTime();
+
+    //! Readable (demangled) name of a type, for region names
+    static std::string typeName(const std::type_info & type);
+
+  private:
+
+    struct Region {
+      std::string name;
+      long calls;
+      double wall, cpu;
+    };
+
+    struct Counter {
+      std::string name;
+      long value;
+    };
+
+    static bool _enabled;
+    static std::vector<Region> _regions;
+    static std::vector<Counter> _counters;
+
+    static void _count(const char * name, long n);
+  };
+
+}; // namespace voom
+
+#endif // __Profiler_h__
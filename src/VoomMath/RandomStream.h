@@ -0,0 +1,147 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+
+/*!
+  \file RandomStream.h
+
+  \brief Small, self-contained random number stream.  Unlike rand()
+  every stream has its own state, so each thread or replica can draw
+  from an independent, reproducible sequence.  CounterRandom has no
+  state at all: its numbers are a function of (seed, stream, counter).
+
+*/
+
+#if !defined(__RandomStream_h__)
+#define __RandomStream_h__
+
+#include <cmath>
+
+namespace voom
+{
+
+  /*!  SplitMix64 generator.  Streams built from the same seed but
+    different stream ids produce statistically independent sequences.
+  */
+  class RandomStream
+  {
+  public:
+
+    typedef unsigned long long Word;
+
+    //! Construct stream number id of the family selected by seed
+    RandomStream(Word seed=0, Word id=0) { this->seed(seed, id); }
+
+    //! Restart the stream
+    void seed(Word seed, Word id=0) {
+      _state = seed;
+      _state = next() ^ (id*0xD1B54A32D192ED03ULL);
+    }
+
+    //! Next 64 random bits
+    Word next() {
+      Word z = (_state += 0x9E3779B97F4A7C15ULL);
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+      return z ^ (z >> 31);
+    }
+
+    //! Uniform double in [0,1)
+    double uniform() { return (next() >> 11) * (1.0/9007199254740992.0); }
+
+    //! Uniform integer in [0,n)
+    unsigned int integer(unsigned int n) {
+      return static_cast<unsigned int>( uniform()*n );
+    }
+
+    //! Standard normal deviate (Box-Muller)
+    double normal() {
+      double u = uniform();
+      while(u <= 0.0) u = uniform();
+      return std::sqrt(-2.0*std::log(u))*std::cos(2.0*M_PI*uniform());
+    }
+
+  private:
+
+    Word _state;
+  };
+
+
+
+  /*!  Counter based generator Philox4x32-10 (Salmon, Moraes, Dror
+    and Shaw, "Parallel random numbers: as easy as 1, 2, 3", SC11).
+    Each call maps (seed, stream, counter) to four independent random
+    words, so a value can be drawn for any (object, step) pair in any
+    order and on any thread with the same result: keying the stream
+    by node or element id and the counter by time step makes a
+    stochastic simulation reproducible at every thread count.
+  */
+  class CounterRandom
+  {
+  public:
+
+    typedef unsigned long long Word;
+    typedef unsigned int Word32;
+
+    CounterRandom(Word seed=0) : _seed(seed) {}
+
+    void seed(Word seed) { _seed = seed; }
+
+    //! The raw Philox4x32-10 bijection of counter ctr under key
+    static void philox(const Word32 ctr[4], const Word32 key[2], Word32 out[4]) {
+      Word32 x0 = ctr[0], x1 = ctr[1], x2 = ctr[2], x3 = ctr[3];
+      Word32 k0 = key[0], k1 = key[1];
+      for(int round=0; round<10; round++) {
+	const Word p0 = 0xD2511F53ULL*x0;
+	const Word p1 = 0xCD9E8D57ULL*x2;
+	const Word32 y0 = Word32(p1 >> 32) ^ x1 ^ k0;
+	const Word32 y2 = Word32(p0 >> 32) ^ x3 ^ k1;
+	x1 = Word32(p1);
+	x3 = Word32(p0);
+	x0 = y0;
+	x2 = y2;
+	k0 += 0x9E3779B9U;
+	k1 += 0xBB67AE85U;
+      }
+      out[0] = x0; out[1] = x1; out[2] = x2; out[3] = x3;
+    }
+
+    //! Four random words for (stream, counter)
+    void words(Word stream, Word counter, Word32 out[4]) const {
+      const Word32 ctr[4] = { Word32(counter), Word32(counter >> 32),
+			      Word32(stream), Word32(stream >> 32) };
+      const Word32 key[2] = { Word32(_seed), Word32(_seed >> 32) };
+      philox(ctr, key, out);
+    }
+
+    //! Four uniform doubles in (0,1) for (stream, counter)
+    void uniform(Word stream, Word counter, double u[4]) const {
+      Word32 w[4];
+      words(stream, counter, w);
+      for(int k=0; k<4; k++) u[k] = (w[k] + 0.5)*(1.0/4294967296.0);
+    }
+
+    //! Four standard normal deviates for (stream, counter) (Box-Muller)
+    void normal(Word stream, Word counter, double z[4]) const {
+      double u[4];
+      uniform(stream, counter, u);
+      for(int k=0; k<4; k+=2) {
+	const double r = std::sqrt(-2.0*std::log(u[k]));
+	z[k]   = r*std::cos(2.0*M_PI*u[k+1]);
+	z[k+1] = r*std::sin(2.0*M_PI*u[k+1]);
+      }
+    }
+
+  private:
+
+    Word _seed;
+  };
+
+}; // namespace voom
+
+#endif // __RandomStream_h__
@@ -0,0 +1,157 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include "SparseMatrix.h"
+
+namespace voom {
+
+  void SparseMatrix::setPattern(const std::vector< IndexContainer > & rows) {
+    _n = rows.size();
+    _rowPtr.assign(_n+1, 0);
+    _col.clear();
+    _diag.assign(_n, -1);
+
+    IndexContainer r;
+    for(int i=0; i<_n; i++) {
+      r = rows[i];
+      std::sort(r.begin(), r.end());
+      r.erase( std::unique(r.begin(), r.end()), r.end() );
+      _col.insert(_col.end(), r.begin(), r.end());
+      _rowPtr[i+1] = _col.size();
+    }
+    _val.assign(_col.size(), 0.0);
+
+    for(int i=0; i<_n; i++) _diag[i] = find(i,i);
+    return;
+  }
+
+  void SparseMatrix::setPattern(int n,
+				const std::vector< IndexContainer > & groups) {
+    std::vector< IndexContainer > rows(n);
+    for(int g=0; g<groups.size(); g++) {
+      const IndexContainer & idx = groups[g];
+      for(int a=0; a<idx.size(); a++) {
+	assert(idx[a] >= 0 && idx[a] < n);
+	rows[idx[a]].insert(rows[idx[a]].end(), idx.begin(), idx.end());
+      }
+    }
+    // keep the diagonal even for dof not touched by any group
+    for(int i=0; i<n; i++) rows[i].push_back(i);
+    setPattern(rows);
+    return;
+  }
+
+  void SparseMatrix::zero() {
+    std::fill(_val.begin(), _val.end(), 0.0);
+  }
+
+  int SparseMatrix::find(int i, int j) const {
+    assert(i >= 0 && i < _n);
+    IndexContainer::const_iterator begin = _col.begin() + _rowPtr[i];
+    IndexContainer::const_iterator end   = _col.begin() + _rowPtr[i+1];
+    IndexContainer::const_iterator k = std::lower_bound(begin, end, j);
+    if(k == end || *k != j) return -1;
+    return k - _col.begin();
+  }
+
+  void SparseMatrix::multiply(const double * x, double * y) const {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i=0; i<_n; i++) {
+      double yi = 0.0;
+      for(int k=_rowPtr[i]; k<_rowPtr[i+1]; k++) yi += _val[k]*x[_col[k]];
+      y[i] = yi;
+    }
+    return;
+  }
+
+  void SparseMatrix::diagonal(double * d) const {
+    for(int i=0; i<_n; i++) d[i] = (_diag[i] < 0 ? 0.0 : _val[_diag[i]]);
+    return;
+  }
+
+  void SparseMatrix::symmetrize() {
+    for(int i=0; i<_n; i++) {
+      for(int k=_rowPtr[i]; k<_rowPtr[i+1]; k++) {
+	const int j = _col[k];
+	if(j <= i) continue;
+	const int kt = find(j,i);
+	if(kt < 0) continue;
+	const double a = 0.5*(_val[k] + _val[kt]);
+	_val[k] = _val[kt] = a;
+      }
+    }
+    return;
+  }
+
+  int conjugateGradient(const SparseMatrix & A, const double * b, double * x,
+			double tol, int maxIter) {
+    return conjugateGradient(A, b, x, tol, maxIter, 0);
+  }
+
+  int conjugateGradient(const SparseMatrix & A, const double * b, double * x,
+			double tol, int maxIter, const Preconditioner * M) {
+    const int n = A.size();
+    std::vector<double> r(n), z(n), p(n), q(n), dinv;
+
+    if(!M) {
+      dinv.resize(n);
+      A.diagonal(&dinv[0]);
+      for(int i=0; i<n; i++) dinv[i] = (dinv[i] > 0.0 ? 1.0/dinv[i] : 1.0);
+    }
+
+    A.multiply(x, &q[0]);
+    double rr=0.0;
+    for(int i=0; i<n; i++) {
+      r[i] = b[i] - q[i];
+      rr += r[i]*r[i];
+    }
+    if(M) M->apply(&r[0], &z[0]);
+    else for(int i=0; i<n; i++) z[i] = dinv[i]*r[i];
+    double rz=0.0;
+    for(int i=0; i<n; i++) {
+      p[i] = z[i];
+      rz += r[i]*z[i];
+    }
+
+    for(int k=0; k<maxIter; k++) {
+      if( std::sqrt(rr) <= tol ) return k;
+
+      A.multiply(&p[0], &q[0]);
+      double pq=0.0;
+      for(int i=0; i<n; i++) pq += p[i]*q[i];
+
+      if( pq <= 0.0 || rz <= 0.0 ) {
+	// negative curvature: keep what we have
+	if(k==0) for(int i=0; i<n; i++) x[i] = b[i];
+	return k;
+      }
+
+      const double alpha = rz/pq;
+      rr = 0.0;
+      for(int i=0; i<n; i++) {
+	x[i] += alpha*p[i];
+	r[i] -= alpha*q[i];
+	rr += r[i]*r[i];
+      }
+      if(M) M->apply(&r[0], &z[0]);
+      else for(int i=0; i<n; i++) z[i] = dinv[i]*r[i];
+      double rzNew=0.0;
+      for(int i=0; i<n; i++) rzNew += r[i]*z[i];
+      const double beta = rzNew/rz;
+      rz = rzNew;
+      for(int i=0; i<n; i++) p[i] = z[i] + beta*p[i];
+    }
+    return ( std::sqrt(rr) <= tol ? maxIter : -1 );
+  }
+
+}; // namespace voom
@@ -0,0 +1,151 @@
+// -*- C++ -*-
+//----------------------------------------------------------------------
+//
+//                          William S. Klug
+//                University of California Los Angeles
+//                   (C) 2014 All Rights Reserved
+//
+//----------------------------------------------------------------------
+
+/*!
+  \file SparseMatrix.h
+
+  \brief SparseMatrix is a compressed sparse row (CSR) matrix with a
+  fixed sparsity pattern, used for assembly of the global stiffness
+  of a Model.
+
+*/
+
+#if !defined(__SparseMatrix_h__)
+#define __SparseMatrix_h__
+
+#include <vector>
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+
+namespace voom
+{
+
+  /*!  Square CSR matrix whose sparsity pattern is built once (e.g.,
+    from element connectivity) and then reused for every assembly.
+    Column indices within each row are kept sorted so that entries can
+    be located by bisection.  Adding to an entry outside of the
+    pattern is an error.
+  */
+  class SparseMatrix
+  {
+  public:
+
+    typedef std::vector<int> IndexContainer;
+    typedef std::vector<double> ValueContainer;
+
+    //! Default Constructor
+    SparseMatrix() : _n(0) { _rowPtr.push_back(0); }
+
+    //! Build the pattern from the (unsorted, possibly repeated)
+    //! column lists of each row.
+    void setPattern(const std::vector< IndexContainer > & rows);
+
+    //! Build the pattern from groups of mutually coupled indices;
+    //! every pair of indices within one group becomes a nonzero.
+    void setPattern(int n, const std::vector< IndexContainer > & groups);
+
+    //! True once a pattern has been set
+    bool hasPattern() const { return _col.size() > 0; }
+
+    //! Number of rows (and columns)
+    int size() const { return _n; }
+
+    //! Number of stored entries
+    int nonZeros() const { return _col.size(); }
+
+    //! Zero the values, keeping the pattern
+    void zero();
+
+    //! Position of entry (i,j) in the value array, or -1 if not stored
+    int find(int i, int j) const;
+
+    //! Access to a stored entry
+    double & operator()(int i, int j) {
+      const int k = find(i,j);
+      if(k < 0) {
+	std::cerr << "SparseMatrix: entry (" << i << "," << j
+		  << ") is not in the sparsity pattern." << std::endl;
+	exit(0);
+      }
+      return _val[k];
+    }
+
+    //! Value of an entry; zero if it is not stored
+    double operator()(int i, int j) const {
+      const int k = find(i,j);
+      return (k < 0 ? 0.0 : _val[k]);
+    }
+
+    //! Add v to entry (i,j)
+    void add(int i, int j, double v) { (*this)(i,j) += v; }
+
+    //! y = A*x
+    void multiply(const double * x, double * y) const;
+
+    //! Copy of the diagonal
+    void diagonal(double * d) const;
+
+    //! Enforce symmetry by averaging A and its transpose
+    void symmetrize();
+
+    const IndexContainer & rowPointers() const { return _rowPtr; }
+    const IndexContainer & columns() const { return _col; }
+    const ValueContainer & values() const { return _val; }
+    ValueContainer & values() { return _val; }
+
+  private:
+
+    int _n;
+
+    //! start of each row in _col/_val; size _n+1
+    IndexContainer _rowPtr;
+
+    //! sorted column index of each stored entry
+    IndexContainer _col;
+
+    //! stored values
+    ValueContainer _val;
+
+    //! position of the diagonal entry of each row (-1 if absent)
+    IndexContainer _diag;
+
+  };
+
+  //! Preconditioner z = M^{-1} r for conjugateGradient
+  class Preconditioner
+  {
+  public:
+    virtual ~Preconditioner() {}
+
+    //! Called whenever the operator has changed (e.g. reassembled)
+    virtual void setOperator(const SparseMatrix & A) {}
+
+    //! z = M^{-1} r; M must be symmetric positive definite
+    virtual void apply(const double * r, double * z) const = 0;
+  };
+
+  //! Jacobi-preconditioned conjugate gradient solution of A*x = b.
+  /*! On entry x holds the initial guess.  Iterations stop when
+    |A*x-b| <= tol or after maxIter iterations.  If a direction of
+    nonpositive curvature is met the current iterate is returned (or b
+    itself on the first iteration), so the result is always usable as
+    a descent direction for an energy with gradient -b.  Returns the
+    number of iterations, or -1 if not converged.
+  */
+  int conjugateGradient(const SparseMatrix & A, const double * b, double * x,
+			double tol, int maxIter);
+
+  //! As above, preconditioned with M (Jacobi if M is null).
+  int conjugateGradient(const SparseMatrix & A, const double * b, double * x,
+			double tol, int maxIter, const Preconditioner * M);
+
+}; // namespace voom
+
+#endif // __SparseMatrix_h__
@@ -0,0 +1,84 @@
+#include <vector>
+#include <iostream>
+#include <cmath>
+#include "Lanczos.h"
+
+// Free-free chain of n unit springs (the 1D Laplacian with Neumann
+// ends).  Its eigenvalues are 2-2cos(k*pi/n), k=0..n-1; the k=0
+// (translation) mode is deflated and the next nev are compared.
+class Chain : public voom::SymmetricOperator
+{
+public:
+  Chain(int n): _n(n) {}
+  int size() const { return _n; }
+  void multiply(const double * x, double * y) {
+    for(int i=0; i<_n; i++) {
+      y[i] = 0.0;
+      if(i>0)    y[i] += x[i]-x[i-1];
+      if(i<_n-1) y[i] += x[i]-x[i+1];
+    }
+  }
+private:
+  int _n;
+};
+
+// Diagonal operator with repeated eigenvalues 1 (x3) and 2 (x5),
+// followed by 11, 12, ...; a single-vector Lanczos sees each
+// repeated value only once.
+class Degenerate : public voom::SymmetricOperator
+{
+public:
+  Degenerate(int n): _d(n) {
+    for(int i=0; i<n; i++) _d[i] = (i<3 ? 1.0 : (i<8 ? 2.0 : 3.0+i));
+  }
+  int size() const { return _d.size(); }
+  void multiply(const double * x, double * y) {
+    for(int i=0; i<_d.size(); i++) y[i] = _d[i]*x[i];
+  }
+  double value(int i) const { return _d[i]; }
+private:
+  std::vector<double> _d;
+};
+
+int main()
+{
+  const int n = 400, nev = 6;
+  Chain A(n);
+
+  std::vector<double> rigid(n, 1.0/std::sqrt(double(n)));
+  std::vector<double> values, vectors;
+  int nconv = voom::lanczos(A, nev, values, &vectors, rigid, 1.0e-10, 500);
+
+  double error = 0.0, residual = 0.0;
+  std::vector<double> y(n);
+  for(int k=0; k<nev; k++) {
+    double exact = 2.0 - 2.0*std::cos((k+1)*M_PI/n);
+    error = std::max(error, std::abs(values[k]-exact)/exact);
+    A.multiply(&vectors[k*n], &y[0]);
+    for(int i=0; i<n; i++)
+      residual = std::max(residual, std::abs(y[i]-values[k]*vectors[k*n+i]));
+    std::cout << values[k] << " (exact " << exact << ")" << std::endl;
+  }
+  std::cout << "converged = " << nconv << " | relative error = " << error
+	    << " | residual = " << residual << std::endl;
+
+  // repeated eigenvalues, with the block as large as the largest
+  // multiplicity
+  const int m = 200, mev = 10;
+  Degenerate B(m);
+  std::vector<double> none;
+  int mconv = voom::lanczos(B, mev, values, &vectors, none, 1.0e-10, 500, -1, 5);
+  double derror = 0.0;
+  for(int k=0; k<mev; k++) {
+    derror = std::max(derror, std::abs(values[k]-B.value(k)));
+    std::cout << values[k] << " (exact " << B.value(k) << ")" << std::endl;
+  }
+  std::cout << "converged = " << mconv << " | error = " << derror << std::endl;
+
+  if(nconv == nev && error < 1.0e-6 && residual < 1.0e-6 &&
+     mconv == mev && derror < 1.0e-8)
+    std::cout << "Lanczos test PASSED!" << std::endl;
+  else
+    std::cout << "Lanczos test FAILED!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,94 @@
+#include <vector>
+#include <iostream>
+#include <cmath>
+#include "Multigrid.h"
+
+// 5-point Laplacian on an n x n grid of interior points of the unit
+// square (n = 2^k - 1) with bilinear interpolation between grids.
+// Multigrid preconditioned CG should converge in a number of
+// iterations that does not grow with the grid, Jacobi CG in a number
+// growing like n.
+
+int index(int n, int i, int j) { return i*n+j; }
+
+void laplacian(int n, voom::SparseMatrix & A)
+{
+  std::vector< std::vector<int> > rows(n*n);
+  for(int i=0; i<n; i++)
+    for(int j=0; j<n; j++) {
+      std::vector<int> & r = rows[index(n,i,j)];
+      r.push_back(index(n,i,j));
+      if(i>0)   r.push_back(index(n,i-1,j));
+      if(i<n-1) r.push_back(index(n,i+1,j));
+      if(j>0)   r.push_back(index(n,i,j-1));
+      if(j<n-1) r.push_back(index(n,i,j+1));
+    }
+  A.setPattern(rows);
+  for(int a=0; a<n*n; a++)
+    for(int k=0; k<rows[a].size(); k++)
+      A.add(a, rows[a][k], rows[a][k]==a ? 4.0 : -1.0);
+}
+
+// fine point (i,j) of an n x n grid from the (n-1)/2 grid
+voom::Prolongation bilinear(int n)
+{
+  const int nc = (n-1)/2;
+  voom::Prolongation P;
+  for(int i=0; i<n; i++)
+    for(int j=0; j<n; j++) {
+      std::vector<int> cols;
+      std::vector<double> weights;
+      // fine index i lies between coarse (i-1)/2 and i/2
+      for(int ci=(i-1)/2; ci<=i/2; ci++)
+	for(int cj=(j-1)/2; cj<=j/2; cj++) {
+	  if(ci<0 || ci>=nc || cj<0 || cj>=nc) continue;
+	  const double wi = ( i%2 ? 1.0 : 0.5 ), wj = ( j%2 ? 1.0 : 0.5 );
+	  cols.push_back(index(nc,ci,cj));
+	  weights.push_back(wi*wj);
+	}
+      P.addRow(cols, weights);
+    }
+  return P;
+}
+
+int main()
+{
+  bool pass = true;
+  int first = -1, last = -1;
+  for(int k=3; k<=7; k++) {
+    const int n = (1<<k)-1;
+    voom::SparseMatrix A;
+    laplacian(n, A);
+
+    std::vector<voom::Prolongation> P;
+    for(int l=2; l<=k; l++) P.push_back( bilinear((1<<l)-1) );
+    voom::Multigrid mg;
+    mg.setHierarchy(P);
+    mg.setOperator(A);
+
+    std::vector<double> b(n*n, 1.0), x(n*n, 0.0), y(n*n, 0.0), r(n*n);
+    const double tol = 1.0e-8*n;
+    const int itMG = voom::conjugateGradient(A, &b[0], &x[0], tol, 1000, &mg);
+    const int itJ = voom::conjugateGradient(A, &b[0], &y[0], tol, 10000);
+
+    A.multiply(&x[0], &r[0]);
+    double res = 0.0;
+    for(int a=0; a<n*n; a++) res = std::max(res, std::abs(r[a]-b[a]));
+
+    std::cout << "n = " << n << " | levels = " << mg.levels()
+	      << " | MG-CG iterations = " << itMG
+	      << " | Jacobi-CG iterations = " << itJ
+	      << " | residual = " << res << std::endl;
+    if( itMG < 0 || res > 1.0e-6 ) pass = false;
+    if( first < 0 ) first = itMG;
+    last = itMG;
+  }
+  // mesh independent: at most a few more iterations on the finest grid
+  if( last > first+3 ) pass = false;
+
+  if(pass)
+    std::cout << "Multigrid test PASSED!" << std::endl;
+  else
+    std::cout << "Multigrid test FAILED!" << std::endl;
+  return 0;
+}
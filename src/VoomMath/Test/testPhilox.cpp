@@ -0,0 +1,46 @@
+#include <iostream>
+#include <cstdio>
+#include <cmath>
+#include "RandomStream.h"
+
+// Known answers of Philox4x32-10 from the Random123 distribution, and
+// the first two moments of the normal deviates.
+int main()
+{
+  typedef voom::CounterRandom::Word32 Word32;
+  const Word32 ctr[3][4] = { {0,0,0,0},
+			     {0xffffffff,0xffffffff,0xffffffff,0xffffffff},
+			     {0x243f6a88,0x85a308d3,0x13198a2e,0x03707344} };
+  const Word32 key[3][2] = { {0,0},
+			     {0xffffffff,0xffffffff},
+			     {0xa4093822,0x299f31d0} };
+  const Word32 known[3][4] = { {0x6627e8d5,0xe169c58d,0xbc57ac4c,0x9b00dbd8},
+			       {0x408f276d,0x41c83b0e,0xa20bc7c6,0x6d5451fd},
+			       {0xd16cfe09,0x94fdcceb,0x5001e420,0x24126ea1} };
+  bool pass = true;
+  for(int t=0; t<3; t++) {
+    Word32 out[4];
+    voom::CounterRandom::philox(ctr[t], key[t], out);
+    for(int k=0; k<4; k++) if(out[k] != known[t][k]) pass = false;
+    printf("%08x %08x %08x %08x\n", out[0], out[1], out[2], out[3]);
+  }
+
+  voom::CounterRandom rng(12345);
+  const int n = 250000;
+  double mean = 0.0, var = 0.0;
+  for(int i=0; i<n; i++) {
+    double z[4];
+    rng.normal(i%1000, i/1000, z);
+    for(int k=0; k<4; k++) { mean += z[k]; var += z[k]*z[k]; }
+  }
+  mean /= 4*n;
+  var = var/(4*n) - mean*mean;
+  std::cout << "mean = " << mean << " | variance = " << var << std::endl;
+  if( std::abs(mean) > 0.01 || std::abs(var-1.0) > 0.01 ) pass = false;
+
+  if(pass)
+    std::cout << "Philox test PASSED!" << std::endl;
+  else
+    std::cout << "Philox test FAILED!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,48 @@
+#include <vector>
+#include <iostream>
+#include <cmath>
+#include "SparseMatrix.h"
+
+// Assemble a 1D chain of two-node springs and compare A*x with the
+// exact product.
+int main()
+{
+  const int n = 6;
+  std::vector< std::vector<int> > groups;
+  for(int e=0; e<n-1; e++) {
+    std::vector<int> idx(2);
+    idx[0] = e; idx[1] = e+1;
+    groups.push_back(idx);
+  }
+
+  voom::SparseMatrix K;
+  K.setPattern(n, groups);
+  std::cout << "nonzeros = " << K.nonZeros() << " (expected " 
+	    << 3*n-2 << ")" << std::endl;
+
+  for(int e=0; e<n-1; e++) {
+    K.add(e,e,1.0);     K.add(e,e+1,-1.0);
+    K.add(e+1,e,-1.0);  K.add(e+1,e+1,1.0);
+  }
+
+  std::vector<double> x(n), y(n);
+  for(int i=0; i<n; i++) x[i] = i*i;
+  K.multiply(&x[0], &y[0]);
+
+  double error = 0.0;
+  for(int i=0; i<n; i++) {
+    double yi = 0.0;
+    if(i>0)   yi += x[i]-x[i-1];
+    if(i<n-1) yi += x[i]-x[i+1];
+    error = std::max(error, std::abs(yi-y[i]));
+  }
+  std::cout << "error = " << error << std::endl;
+
+  const voom::SparseMatrix & Kc = K;
+  if( K.nonZeros() == 3*n-2 && error < 1.0e-12 && Kc(0,5) == 0.0 ) {
+    std::cout << "SparseMatrix test PASSED!" << std::endl;
+    return 0;
+  }
+  std::cout << "SparseMatrix test FAILED!" << std::endl;
+  return 1;
+}